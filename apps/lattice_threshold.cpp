@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <algo_lib/lattice_percolation.h>
+#include <algo_lib/percolation.h>
+
+// Estimates site percolation thresholds on the different lattices by opening
+// sites in random order until the box percolates, and times the opens against
+// the plain 2D Percolation class.
+
+namespace {
+
+void usage(const char* argv0, const std::string& error)
+{
+	if (!error.empty())
+	{
+		std::cerr << error << std::endl;
+	}
+
+	std::cerr << "Usage: " << std::endl;
+	std::cerr << argv0 << " <L:int> <T:int>" << std::endl;
+	std::cerr << "...where L is the side length of the 2D squares (the 3D cubes use L^(2/3))" << std::endl;
+	std::cerr << "...and T is the number of random trials to run per lattice." << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], int& outL, int& outT)
+{
+	if (argc != 3)
+	{
+		usage(argv[0], std::string("Incorrect number of arguments provided."));
+		return false;
+	}
+
+	try
+	{
+		outL = std::stoi(std::string(argv[1]));
+		outT = std::stoi(std::string(argv[2]));
+	}
+	catch (const std::exception& ex)
+	{
+		std::stringstream err;
+		err << "Could not parse arguments as ints: " << argv[1] << " " << argv[2] << std::endl;
+		err << "Reason: " << ex.what() << std::endl;
+		usage(argv[0], err.str());
+		return false;
+	}
+
+	if (outL <= 0 || outT <= 0)
+	{
+		usage(argv[0], std::string("L and T must both be positive."));
+		return false;
+	}
+
+	return true;
+}
+
+// order holds every site once; trial t opens them in the t'th shuffle of it
+// until perc percolates. openSite(perc, element) does the opening.
+template <typename Perc, typename Site, typename OpenSite>
+void runTrials(const char* name, Perc& perc, std::vector<Site> order, int trials, OpenSite openSite)
+{
+	std::mt19937_64 randEng;
+	long long totalOpened{0};
+	std::chrono::steady_clock::duration elapsed{0};
+
+	for (int t = 0; t < trials; t++)
+	{
+		std::shuffle(order.begin(), order.end(), randEng);
+		perc.ResetGrid();
+
+		// only time the percolation work, not the shuffle.
+		auto beginTime = std::chrono::steady_clock::now();
+		for (const Site& site : order)
+		{
+			openSite(perc, site);
+			totalOpened++;
+			if (perc.DoesPercolate()) break;
+		}
+		elapsed += std::chrono::steady_clock::now() - beginTime;
+	}
+
+	const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+	std::cout << name << ": mean threshold " << (static_cast<double>(totalOpened) / trials / order.size())
+			  << ", " << (1e6 * ms / totalOpened) << " ns per opened site" << std::endl;
+}
+
+template <typename Perc>
+void runLattice(const char* name, const typename Perc::Coords& extents, int trials)
+{
+	Perc perc(extents);
+	std::vector<typename Perc::Coords> order(perc.Sites());
+	for (int site = 0; site < perc.Sites(); site++) order[site] = perc.SiteCoords(site);
+	runTrials(name, perc, std::move(order), trials,
+		[](Perc& p, const typename Perc::Coords& coords) { p.Open(coords); });
+}
+
+} /* anon namespace */
+
+int main(int argc, char* argv[])
+{
+	int L;
+	int T;
+
+	if (!parseArgs(argc, argv, L, T))
+	{
+		return 1;
+	}
+
+	try
+	{
+		namespace nsperc = mabz::percolation;
+		namespace lattice = mabz::percolation::lattice;
+		const int cubeSide = std::max(2, static_cast<int>(std::cbrt(static_cast<double>(L) * L)));
+
+		nsperc::Percolation grid(L);
+		std::vector<std::pair<int,int> > cells;
+		for (int r = 1; r <= L; r++)
+		{
+			for (int c = 1; c <= L; c++) cells.emplace_back(r, c);
+		}
+		runTrials("Percolation (reference)", grid, std::move(cells), T,
+			[](nsperc::Percolation& p, const std::pair<int,int>& cell) { p.Open(cell.first, cell.second); });
+
+		runLattice<nsperc::LatticePercolation<lattice::Square> >("Square", {L, L}, T);
+		runLattice<nsperc::LatticePercolation<lattice::Square, true> >("Square, periodic", {L, L}, T);
+		runLattice<nsperc::LatticePercolation<lattice::Triangular> >("Triangular", {L, L}, T);
+		runLattice<nsperc::LatticePercolation<lattice::Cubic> >("Cubic", {cubeSide, cubeSide, cubeSide}, T);
+		runLattice<nsperc::LatticePercolation<lattice::Cubic, true> >("Cubic, periodic", {cubeSide, cubeSide, cubeSide}, T);
+		return 0;
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << "Unanticipated exception: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/newman_ziff.h>
+
+// Prints percolation observables as a smooth function of the open probability p,
+// as CSV, from one Newman-Ziff sweep per run. Replaces running the percolation
+// app (or a fixed-p simulation) once per point of the curve.
+
+namespace {
+
+void usage(const char* argv0, const std::string& error)
+{
+	if (!error.empty())
+	{
+		std::cerr << error << std::endl;
+	}
+
+	std::cerr << "Usage: " << std::endl;
+	std::cerr << argv0 << " <n:int> <runs:int> <points:int>" << std::endl;
+	std::cerr << "...where n is the side length of the square grid," << std::endl;
+	std::cerr << "...runs is the number of random sweeps to average over" << std::endl;
+	std::cerr << "...and points is the number of evenly spaced p values in [0, 1] to print." << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], int& outN, int& outRuns, int& outPoints)
+{
+	if (argc != 4)
+	{
+		usage(argv[0], std::string("Incorrect number of arguments provided."));
+		return false;
+	}
+
+	try
+	{
+		outN = std::stoi(std::string(argv[1]));
+		outRuns = std::stoi(std::string(argv[2]));
+		outPoints = std::stoi(std::string(argv[3]));
+	}
+	catch (const std::exception& ex)
+	{
+		std::stringstream err;
+		err << "Could not parse arguments as ints." << std::endl;
+		err << "Reason: " << ex.what() << std::endl;
+		usage(argv[0], err.str());
+		return false;
+	}
+
+	if (outPoints < 2)
+	{
+		usage(argv[0], std::string("Need at least 2 points."));
+		return false;
+	}
+
+	return true;
+}
+
+} /* anon namespace */
+
+int main(int argc, char* argv[])
+{
+	int n;
+	int runs;
+	int points;
+
+	if (!parseArgs(argc, argv, n, runs, points))
+	{
+		return 1;
+	}
+
+	try
+	{
+		auto beginTime = std::chrono::steady_clock::now();
+		mabz::percolation::NewmanZiff nz(n, runs);
+		auto endTime = std::chrono::steady_clock::now();
+
+		std::cerr << "Sweeps took "
+				  << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - beginTime).count()
+				  << " ms" << std::endl;
+
+		std::cout << "p,spanning,largest_cluster_fraction,mean_cluster_size" << std::endl;
+		for (int i = 0; i < points; i++)
+		{
+			const double p = static_cast<double>(i) / (points - 1);
+			const auto obs = nz.At(p);
+			std::cout << p << "," << obs.mSpanning << "," << obs.mLargestClusterFraction
+					  << "," << obs.mMeanClusterSize << std::endl;
+		}
+		return 0;
+	}
+	catch (const mabz::IllegalArgumentException& ex)
+	{
+		std::cerr << "Attempted to run Newman-Ziff with illegal arguments: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << "Unanticipated exception: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+}
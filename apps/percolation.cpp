@@ -15,14 +15,15 @@ void usage(const char* argv0, const std::string& error)
 	}
 
 	std::cerr << "Usage: " << std::endl;
-	std::cerr << argv0 << " <n:int> <T:int>" << std::endl;
+	std::cerr << argv0 << " <n:int> <T:int> [threads:int]" << std::endl;
 	std::cerr << "...where n is the side length of the square grid" << std::endl;
-	std::cerr << "...and T is the number of random trials to run." << std::endl;
+	std::cerr << "...and T is the number of random trials to run" << std::endl;
+	std::cerr << "...and threads is how many threads to run them on (default: one per core)." << std::endl;
 }
 
-bool parseArgs(int argc, char* argv[], int& outN, int& outT)
+bool parseArgs(int argc, char* argv[], int& outN, int& outT, int& outThreads)
 {
-	if (argc != 3)
+	if (argc != 3 && argc != 4)
 	{
 		usage(argv[0], std::string("Incorrect number of arguments provided."));
 		return false;
@@ -54,6 +55,23 @@ bool parseArgs(int argc, char* argv[], int& outN, int& outT)
 		return false;
 	}
 
+	outThreads = 0;
+	if (argc == 4)
+	{
+		try
+		{
+			outThreads = std::stoi(std::string(argv[3]));
+		}
+		catch (const std::exception& ex)
+		{
+			std::stringstream err;
+			err << "Could not parse argument \"threads\" as int: " << argv[3] << std::endl;
+			err << "Reason: " << ex.what() << std::endl;
+			usage(argv[0], err.str());
+			return false;
+		}
+	}
+
 	return true;
 }
 
@@ -61,8 +79,9 @@ int main(int argc, char* argv[])
 {
 	int n;
 	int T;
+	int threads;
 	
-	if (!parseArgs(argc, argv, n, T))
+	if (!parseArgs(argc, argv, n, T, threads))
 	{
 		return 1;
 	}
@@ -75,7 +94,7 @@ int main(int argc, char* argv[])
 	try
 	{
 		auto beginTime = std::chrono::steady_clock::now();
-		mabz::percolation::PercolationStats pstats(n, T);
+		mabz::percolation::PercolationStats pstats(n, T, threads);
 		auto endTime = std::chrono::steady_clock::now();
 
 		std::cout << "Time taken: " 
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <algo_lib/cell_index.h>
+#include <algo_lib/percolation.h>
+
+// Compares the cell layouts of BasicPercolation on big grids, where row-major's
+// vertical neighbours being n ints apart means a cache miss on nearly every
+// vertical union. Each trial opens cells in random order until the grid
+// percolates. Try n = 2048, 8192 and 32768 (the last needs ~10GB).
+
+namespace {
+
+void usage(const char* argv0, const std::string& error)
+{
+	if (!error.empty())
+	{
+		std::cerr << error << std::endl;
+	}
+
+	std::cerr << "Usage: " << std::endl;
+	std::cerr << argv0 << " <n:int> <T:int>" << std::endl;
+	std::cerr << "...where n is the side length of the square grid" << std::endl;
+	std::cerr << "...and T is the number of random trials to run per layout." << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], int& outN, int& outT)
+{
+	if (argc != 3)
+	{
+		usage(argv[0], std::string("Incorrect number of arguments provided."));
+		return false;
+	}
+
+	try
+	{
+		outN = std::stoi(std::string(argv[1]));
+		outT = std::stoi(std::string(argv[2]));
+	}
+	catch (const std::exception& ex)
+	{
+		std::stringstream err;
+		err << "Could not parse arguments as ints: " << argv[1] << " " << argv[2] << std::endl;
+		err << "Reason: " << ex.what() << std::endl;
+		usage(argv[0], err.str());
+		return false;
+	}
+
+	if (outN <= 0 || outT <= 0)
+	{
+		usage(argv[0], std::string("n and T must both be positive."));
+		return false;
+	}
+
+	return true;
+}
+
+// Every layout sees the same sequence of shuffled grids, so timings are comparable.
+template <typename CellIndex>
+void runLayoutTrials(const char* name, int n, int trials)
+{
+	// cell numbers r * n + c, 0-based, rather than pairs to halve the memory.
+	std::vector<std::uint32_t> cells(static_cast<std::size_t>(n) * n);
+	std::iota(cells.begin(), cells.end(), 0u);
+	std::mt19937_64 randEng;
+
+	mabz::percolation::BasicPercolation<mabz::DefaultUnionFindPolicy, CellIndex> percolation(n);
+	long long totalOpened{0};
+	std::chrono::steady_clock::duration elapsed{0};
+
+	for (int t = 0; t < trials; t++)
+	{
+		std::shuffle(cells.begin(), cells.end(), randEng);
+		percolation.ResetGrid();
+
+		// only time the percolation work, not the shuffle.
+		auto beginTime = std::chrono::steady_clock::now();
+		for (std::uint32_t cell : cells)
+		{
+			percolation.Open(1 + static_cast<int>(cell / n), 1 + static_cast<int>(cell % n));
+			totalOpened++;
+			if (percolation.DoesPercolate()) break;
+		}
+		elapsed += std::chrono::steady_clock::now() - beginTime;
+	}
+
+	const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+	std::cout << name << ": " << ms << " ms total, "
+			  << (1e6 * ms / totalOpened) << " ns per opened cell, "
+			  << "mean threshold " << (static_cast<double>(totalOpened) / trials / n / n) << std::endl;
+}
+
+} /* anon namespace */
+
+int main(int argc, char* argv[])
+{
+	int n;
+	int T;
+
+	if (!parseArgs(argc, argv, n, T))
+	{
+		return 1;
+	}
+
+	std::cout << "Running " << T << " percolation trials per cell layout with grid side length " << n << std::endl;
+
+	try
+	{
+		namespace layout = mabz::percolation::cell_index;
+		runLayoutTrials<layout::RowMajor>("RowMajor", n, T);
+		runLayoutTrials<layout::Morton>("Morton", n, T);
+		runLayoutTrials<layout::BlockedTiles<8> >("BlockedTiles<8>", n, T);
+		runLayoutTrials<layout::BlockedTiles<16> >("BlockedTiles<16>", n, T);
+		runLayoutTrials<layout::BlockedTiles<32> >("BlockedTiles<32>", n, T);
+		return 0;
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << "Unanticipated exception: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+}
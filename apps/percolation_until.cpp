@@ -0,0 +1,110 @@
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/percolation.h>
+
+// Estimates the percolation threshold to a requested precision rather than for
+// a fixed number of trials: keeps running trials until the 95% confidence
+// interval is narrow enough, or the time limit runs out.
+
+namespace {
+
+void usage(const char* argv0, const std::string& error)
+{
+	if (!error.empty())
+	{
+		std::cerr << error << std::endl;
+	}
+
+	std::cerr << "Usage: " << std::endl;
+	std::cerr << argv0 << " <n:int> <halfWidth:double> [seconds:int] [threads:int]" << std::endl;
+	std::cerr << "...where n is the side length of the square grid" << std::endl;
+	std::cerr << "...and halfWidth is the 95% confidence half-width to stop at" << std::endl;
+	std::cerr << "...and seconds is a time limit (default: none)" << std::endl;
+	std::cerr << "...and threads is how many threads to run on (default: one per core)." << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], int& outN, double& outHalfWidth, long long& outSeconds, int& outThreads)
+{
+	if (argc < 3 || argc > 5)
+	{
+		usage(argv[0], std::string("Incorrect number of arguments provided."));
+		return false;
+	}
+
+	try
+	{
+		outN = std::stoi(std::string(argv[1]));
+		outHalfWidth = std::stod(std::string(argv[2]));
+		outSeconds = argc > 3 ? std::stoll(std::string(argv[3])) : -1;
+		outThreads = argc > 4 ? std::stoi(std::string(argv[4])) : 0;
+	}
+	catch (const std::exception& ex)
+	{
+		std::stringstream err;
+		err << "Could not parse arguments." << std::endl;
+		err << "Reason: " << ex.what() << std::endl;
+		usage(argv[0], err.str());
+		return false;
+	}
+
+	return true;
+}
+
+} /* anon namespace */
+
+int main(int argc, char* argv[])
+{
+	int n;
+	double halfWidth;
+	long long seconds;
+	int threads;
+
+	if (!parseArgs(argc, argv, n, halfWidth, seconds, threads))
+	{
+		return 1;
+	}
+
+	try
+	{
+		const std::chrono::milliseconds budget = seconds < 0
+			? std::chrono::milliseconds::max()
+			: std::chrono::milliseconds(std::chrono::seconds(seconds));
+
+		auto beginTime = std::chrono::steady_clock::now();
+		const auto pstats = mabz::percolation::PercolationStats::UntilHalfWidth(n, halfWidth, budget, threads);
+		auto endTime = std::chrono::steady_clock::now();
+
+		std::cout << "Time taken: "
+		          << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - beginTime).count()
+		          << " ms" << std::endl;
+
+		std::cout << "Trials: " << pstats.Trials() << std::endl;
+		std::cout << "Mean: " << pstats.Mean() << std::endl;
+		std::cout << "Stdev: " << pstats.Stdev() << std::endl;
+		std::cout << "ConfidenceLow: " << pstats.ConfidenceLow() << std::endl;
+		std::cout << "ConfidenceHigh: " << pstats.ConfidenceHigh() << std::endl;
+		if (pstats.ConfidenceHigh() - pstats.Mean() > halfWidth)
+		{
+			std::cout << "Ran out of time before reaching the requested half-width." << std::endl;
+		}
+
+		return 0;
+	}
+	catch (const mabz::IllegalArgumentException& ex)
+	{
+		std::cerr << "Attempted to run percolation stats with illegal arguments: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << "Unanticipated exception: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <algo_lib/compact_union_find.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/percolation.h>
+#include <algo_lib/union_find.h>
+
+// Compares the union-find policies on percolation-style workloads:
+// opening the cells of an n-by-n grid in random order until it percolates,
+// which is exactly what PercolationStats does for every trial.
+
+namespace {
+
+// Quick-find relabels on every union, so it's O(n^4) per trial on an n-by-n grid.
+// Past this side length we skip it rather than wait all day.
+const int kMaxQuickFindN{128};
+
+void usage(const char* argv0, const std::string& error)
+{
+	if (!error.empty())
+	{
+		std::cerr << error << std::endl;
+	}
+
+	std::cerr << "Usage: " << std::endl;
+	std::cerr << argv0 << " <n:int> <T:int>" << std::endl;
+	std::cerr << "...where n is the side length of the square grid" << std::endl;
+	std::cerr << "...and T is the number of random trials to run per policy." << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], int& outN, int& outT)
+{
+	if (argc != 3)
+	{
+		usage(argv[0], std::string("Incorrect number of arguments provided."));
+		return false;
+	}
+
+	try
+	{
+		outN = std::stoi(std::string(argv[1]));
+		outT = std::stoi(std::string(argv[2]));
+	}
+	catch (const std::exception& ex)
+	{
+		std::stringstream err;
+		err << "Could not parse arguments as ints: " << argv[1] << " " << argv[2] << std::endl;
+		err << "Reason: " << ex.what() << std::endl;
+		usage(argv[0], err.str());
+		return false;
+	}
+
+	if (outN <= 0 || outT <= 0)
+	{
+		usage(argv[0], std::string("n and T must both be positive."));
+		return false;
+	}
+
+	return true;
+}
+
+// Every policy sees the same sequence of shuffled grids, so timings are comparable.
+template <typename Policy>
+void runPercolationTrials(const char* name, int n, int trials)
+{
+	if (std::is_same<Policy, mabz::uf_policy::QuickFind>::value && n > kMaxQuickFindN)
+	{
+		std::cout << name << ": skipped (n > " << kMaxQuickFindN << ")" << std::endl;
+		return;
+	}
+
+	auto randEng = std::default_random_engine{};
+	std::vector<std::pair<int,int> > cells;
+	for (int r = 1; r <= n; r++)
+	{
+		for (int c = 1; c <= n; c++)
+		{
+			cells.emplace_back(r, c);
+		}
+	}
+
+	mabz::percolation::BasicPercolation<Policy> percolation(n);
+	long long totalOpened{0};
+	std::chrono::steady_clock::duration elapsed{0};
+
+	for (int t = 0; t < trials; t++)
+	{
+		std::shuffle(std::begin(cells), std::end(cells), randEng);
+		percolation.ResetGrid();
+
+		// only time the union-find work, not the shuffle.
+		auto beginTime = std::chrono::steady_clock::now();
+		for (auto& rowCol : cells)
+		{
+			percolation.Open(rowCol.first, rowCol.second);
+			totalOpened++;
+			if (percolation.DoesPercolate()) break;
+		}
+		elapsed += std::chrono::steady_clock::now() - beginTime;
+	}
+
+	const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+	std::cout << name << ": " << ms << " ms total, "
+			  << (1e6 * ms / totalOpened) << " ns per opened cell, "
+			  << "mean threshold " << (static_cast<double>(totalOpened) / trials / n / n) << std::endl;
+}
+
+// Random unions then random queries over n*n sites, one call per pair versus
+// the prefetching batch entry points. Random pairs are the worst
+// case for the cache, which is where the batch path is meant to help.
+void runRandomPairs(int n)
+{
+	const int sites = n*n;
+	auto randEng = std::default_random_engine{};
+	std::uniform_int_distribution<int> dist(0, sites-1);
+	std::vector<std::pair<int,int> > pairs(sites);
+	for (auto& p : pairs)
+	{
+		p = std::make_pair(dist(randEng), dist(randEng));
+	}
+	std::unique_ptr<bool[]> results(new bool[pairs.size()]);
+
+	auto timeMs = [](auto&& func) ->double {
+		auto beginTime = std::chrono::steady_clock::now();
+		func();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beginTime).count();
+	};
+
+	mabz::UnionFind<> single(sites);
+	const double singleUnionMs = timeMs([&]() { for (auto& p : pairs) single.Union(p.first, p.second); });
+	const double singleConnectedMs = timeMs([&]() {
+		for (std::size_t i = 0; i < pairs.size(); i++) results[i] = single.Connected(pairs[i].second, pairs[i].first);
+	});
+
+	mabz::UnionFind<> batched(sites);
+	const double batchUnionMs = timeMs([&]() { batched.UnionBatch(pairs.data(), pairs.size()); });
+	const double batchConnectedMs = timeMs([&]() { batched.ConnectedBatch(pairs.data(), pairs.size(), results.get()); });
+
+	mabz::CompactUnionFind<std::uint32_t> compact(sites);
+	const double compactUnionMs = timeMs([&]() { for (auto& p : pairs) compact.Union(p.first, p.second); });
+	const double compactConnectedMs = timeMs([&]() {
+		for (std::size_t i = 0; i < pairs.size(); i++) results[i] = compact.Connected(pairs[i].second, pairs[i].first);
+	});
+
+	std::cout << "Random pairs over " << sites << " sites (default policy):" << std::endl;
+	std::cout << "  Union: " << singleUnionMs << " ms single, " << batchUnionMs << " ms batched, "
+			  << compactUnionMs << " ms compact" << std::endl;
+	std::cout << "  Connected: " << singleConnectedMs << " ms single, " << batchConnectedMs << " ms batched, "
+			  << compactConnectedMs << " ms compact" << std::endl;
+}
+
+} /* anon namespace */
+
+int main(int argc, char* argv[])
+{
+	int n;
+	int T;
+
+	if (!parseArgs(argc, argv, n, T))
+	{
+		return 1;
+	}
+
+	std::cout << "Running " << T << " percolation trials per policy with grid side length " << n << std::endl;
+
+	try
+	{
+		namespace pol = mabz::uf_policy;
+		runPercolationTrials<pol::QuickFind>("QuickFind", n, T);
+		runPercolationTrials<pol::WeightedQuickUnion>("WeightedQuickUnion", n, T);
+		runPercolationTrials<pol::UnionByRank>("UnionByRank", n, T);
+		runPercolationTrials<pol::PathCompression>("PathCompression", n, T);
+		runPercolationTrials<pol::PathHalving>("PathHalving", n, T);
+		runPercolationTrials<pol::PathSplitting>("PathSplitting", n, T);
+		runRandomPairs(n);
+		return 0;
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << "Unanticipated exception: " << std::endl;
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace mabz {
+
+inline int PopCount64(std::uint64_t x)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return static_cast<int>(__popcnt64(x));
+#else
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// rows x cols grid of bits, one bit per cell, packed into 64-bit words.
+// Each row starts on a fresh word (the tail of its last word is always zero),
+// so whole-row queries are a handful of word operations rather than per-cell
+// tests. The number of set bits is kept up to date as bits are set, so Count()
+// is O(1). Row and col are 0-based and NOT bounds checked: callers validate.
+class BitGrid
+{
+private:
+	int mRows;
+	int mCols;
+	int mWordsPerRow;
+	std::vector<std::uint64_t> mWords;
+	long long mSetCount{0};
+
+	std::size_t WordIndex(int row, int col) const
+	{
+		return static_cast<std::size_t>(row) * mWordsPerRow + (col >> 6);
+	}
+	static std::uint64_t BitMask(int col) { return std::uint64_t{1} << (col & 63); }
+
+public:
+	BitGrid(int rows, int cols)
+		: mRows(rows)
+		, mCols(cols)
+		, mWordsPerRow((cols + 63) / 64)
+		, mWords(static_cast<std::size_t>(rows) * ((cols + 63) / 64), 0)
+	{}
+
+	int Rows() const { return mRows; }
+	int Cols() const { return mCols; }
+
+	bool Get(int row, int col) const
+	{
+		return (mWords[WordIndex(row, col)] & BitMask(col)) != 0;
+	}
+
+	// Sets the bit; returns true if it wasn't already set.
+	bool Set(int row, int col)
+	{
+		std::uint64_t& word = mWords[WordIndex(row, col)];
+		const std::uint64_t mask = BitMask(col);
+		if (word & mask) return false;
+		word |= mask;
+		mSetCount++;
+		return true;
+	}
+
+	void ClearAll()
+	{
+		for (auto& word : mWords) word = 0;
+		mSetCount = 0;
+	}
+
+	long long Count() const { return mSetCount; }
+
+	int CountInRow(int row) const
+	{
+		const std::uint64_t* words = mWords.data() + static_cast<std::size_t>(row) * mWordsPerRow;
+		int count{0};
+		for (int w = 0; w < mWordsPerRow; w++) count += PopCount64(words[w]);
+		return count;
+	}
+
+	bool AnyInRow(int row) const
+	{
+		const std::uint64_t* words = mWords.data() + static_cast<std::size_t>(row) * mWordsPerRow;
+		std::uint64_t any{0};
+		for (int w = 0; w < mWordsPerRow; w++) any |= words[w];
+		return any != 0;
+	}
+
+	// Bytes used by the bits themselves.
+	std::size_t MemoryUsage() const { return mWords.size() * sizeof(std::uint64_t); }
+};
+
+} /* namespace mabz */
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <climits>
+#include <sstream>
+
+#include <algo_lib/bit_grid.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz { namespace percolation {
+
+// Which bond of a site: the one to the site on its right, or below it.
+enum class BondDirection
+{
+	Right,
+	Down,
+};
+
+class BondPercolationStats;
+
+// Bond percolation on an n-by-n grid: every site is there from the start and
+// what gets opened are the bonds between neighbouring sites. The system
+// percolates when open bonds join some top row site to some bottom row site.
+//
+// Bond (row, col, dir) has id 2 * site + dir, where site = n*(row-1) + (col-1)
+// and dir is 0 for Right and 1 for Down. Decoding an id is then a shift and a
+// mask rather than a division. The ids of the bonds off the right and bottom
+// edges are never opened, so the bit per id storage is 2n^2 bits for the
+// 2n(n-1) real bonds.
+template <typename UnionFindPolicy = mabz::DefaultUnionFindPolicy>
+class BasicBondPercolation
+{
+private:
+	int mN;
+	// node 0 joins the whole top row, node n^2 + 1 the whole bottom row, and
+	// site s is node 1 + s.
+	mabz::UnionFind<UnionFindPolicy> mConnections;
+	// bit id is set if bond id is open.
+	mabz::BitGrid mBonds;
+	long long mOpenBonds{0};
+
+	// Throws IllegalArgumentException unless 0 < n and 2n^2 fits in an int.
+	static int CheckedSideLength(int n);
+
+	// Throw IllegalArgumentException if (row, col) is out of bounds or the bond
+	// would leave the grid.
+	void CheckBond(int row, int col, BondDirection dir) const;
+	int BondId(int row, int col, BondDirection dir) const
+	{
+		return 2 * (mN * (row-1) + (col-1)) + (dir == BondDirection::Down ? 1 : 0);
+	}
+
+	// The fast path for BondPercolationStats, which only ever passes ids of
+	// real bonds: no bounds checks at all, here or in the union-find. A real
+	// bond joins two sites of the grid, so both nodes are in range.
+	void OpenBondUnchecked(int id)
+	{
+		if (!mBonds.Set(0, id)) return;
+		mOpenBonds++;
+		const int site{id >> 1};
+		const int other{site + ((id & 1) ? mN : 1)};
+		mConnections.UnionUnchecked(1 + site, 1 + other);
+	}
+
+	friend class BondPercolationStats;
+
+public:
+	// creates the n-by-n grid of sites with all bonds closed.
+	BasicBondPercolation(int n);
+
+	int N() const { return mN; }
+	// number of real bonds, 2n(n-1).
+	int BondCount() const { return 2 * mN * (mN - 1); }
+
+	// Lets you clear everything and start again if you want.
+	void ResetGrid();
+
+	// opens the bond from (row, col) to its right / lower neighbour, if it is
+	// not open already.
+	void OpenBond(int row, int col, BondDirection dir);
+	bool IsBondOpen(int row, int col, BondDirection dir) const;
+
+	// is the site joined to the top row by open bonds? Top row sites are
+	// always full.
+	bool IsFull(int row, int col) const;
+
+	long long GetNumberOfOpenBonds() const { return mOpenBonds; }
+
+	// the entry and exit nodes always exist, so no need to check them.
+	bool DoesPercolate() const { return mConnections.ConnectedUnchecked(0, mN*mN + 1); }
+};
+
+using BondPercolation = BasicBondPercolation<>;
+
+template <typename UnionFindPolicy>
+int BasicBondPercolation<UnionFindPolicy>::CheckedSideLength(int n)
+{
+	if (n <= 0 || 2LL * n * n > INT_MAX - 2)
+	{
+		std::stringstream err;
+		err << "Must construct BondPercolation class with 0 < n <= 32767. Instead got " << n;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	return n;
+}
+
+template <typename UnionFindPolicy>
+BasicBondPercolation<UnionFindPolicy>::BasicBondPercolation(int n)
+	: mN(CheckedSideLength(n))
+	, mConnections(n*n + 2)
+	, mBonds(1, 2*n*n)
+{
+	ResetGrid();
+}
+
+template <typename UnionFindPolicy>
+void BasicBondPercolation<UnionFindPolicy>::ResetGrid()
+{
+	mConnections.Reset();
+	mBonds.ClearAll();
+	mOpenBonds = 0;
+
+	// sites are always there, so the top and bottom rows are always joined to
+	// the entry and exit nodes.
+	for (int col = 0; col < mN; col++)
+	{
+		mConnections.Union(0, 1 + col);
+		mConnections.Union(mN*mN + 1, 1 + mN*(mN-1) + col);
+	}
+}
+
+template <typename UnionFindPolicy>
+void BasicBondPercolation<UnionFindPolicy>::CheckBond(int row, int col, BondDirection dir) const
+{
+	if (row < 1 || row > mN)
+	{
+		std::stringstream err;
+		err << "Row index must be between 1 and " << mN << " inclusive. Got " << row;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	if (col < 1 || col > mN)
+	{
+		std::stringstream err;
+		err << "Col index must be between 1 and " << mN << " inclusive. Got " << col;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	if ((dir == BondDirection::Right && col == mN) || (dir == BondDirection::Down && row == mN))
+	{
+		std::stringstream err;
+		err << "There is no bond " << (dir == BondDirection::Right ? "right" : "down")
+		    << " from (" << row << ", " << col << ") in a " << mN << " by " << mN << " grid";
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+template <typename UnionFindPolicy>
+void BasicBondPercolation<UnionFindPolicy>::OpenBond(int row, int col, BondDirection dir)
+{
+	CheckBond(row, col, dir);
+	OpenBondUnchecked(BondId(row, col, dir));
+}
+
+template <typename UnionFindPolicy>
+bool BasicBondPercolation<UnionFindPolicy>::IsBondOpen(int row, int col, BondDirection dir) const
+{
+	CheckBond(row, col, dir);
+	return mBonds.Get(0, BondId(row, col, dir));
+}
+
+template <typename UnionFindPolicy>
+bool BasicBondPercolation<UnionFindPolicy>::IsFull(int row, int col) const
+{
+	if (row < 1 || row > mN || col < 1 || col > mN)
+	{
+		std::stringstream err;
+		err << "Row and col indices must be between 1 and " << mN << " inclusive. Got "
+		    << row << ", " << col;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	return mConnections.Connected(0, 1 + mN*(row-1) + (col-1));
+}
+
+class BondPercolationStats
+{
+private:
+	double mMean;
+	double mStdev;
+	double mConfidenceLow;
+	double mConfidenceHigh;
+
+public:
+	// perform independent trials on an n-by-n grid (n >= 2, so there are bonds),
+	// opening bonds in random order until it percolates. The threshold of a
+	// trial is the fraction of the 2n(n-1) bonds that were open.
+	BondPercolationStats(int n, int trials);
+
+	// sample mean of percolation threshold
+	double Mean() const { return mMean; }
+
+	// sample standard deviation of percolation threshold
+	double Stdev() const { return mStdev; }
+
+	// low endpoint of 95% confidence interval
+	double ConfidenceLow() const { return mConfidenceLow; }
+
+	// high endpoint of 95% confidence interval
+	double ConfidenceHigh() const { return mConfidenceHigh; }
+};
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <algo_lib/union_find.h>
+
+namespace mabz {
+
+// Bulk construction of a UnionFind from a whole edge list at once, using every
+// core instead of calling Union one edge at a time.
+//
+// The edges are split into contiguous ranges, one per thread, and all threads
+// link into a single lock-free ConcurrentUnionFind. Once they're done, every
+// site's root is found (also in parallel) and the result is handed to
+// UnionFind::FromRoots, so the returned structure starts out fully compressed.
+// threadCount <= 0 means one thread per hardware thread.
+// Throws IndexOutOfRange if any edge names a site outside [0, capacity).
+
+// Root of every site after linking all the edges; the non-templated core of the
+// functions below.
+std::vector<int> ParallelComponentRoots(int capacity, const std::pair<int,int>* edges,
+	std::size_t edgeCount, int threadCount=0);
+
+// Same, with the edges streamed straight out of a binary file of native-endian
+// int32 (a, b) pairs. The file is memory mapped, so it never has to fit in RAM
+// and the threads each read their own part of it sequentially.
+// Throws FileError if the file can't be mapped (an empty file can't be) or isn't
+// a whole number of pairs.
+std::vector<int> ParallelComponentRootsFromFile(int capacity, const std::string& path, int threadCount=0);
+
+template <typename Policy = DefaultUnionFindPolicy>
+UnionFind<Policy> BuildUnionFind(int capacity, const std::pair<int,int>* edges,
+	std::size_t edgeCount, int threadCount=0)
+{
+	return UnionFind<Policy>::FromRoots(ParallelComponentRoots(capacity, edges, edgeCount, threadCount));
+}
+
+template <typename Policy = DefaultUnionFindPolicy>
+UnionFind<Policy> BuildUnionFind(int capacity, const std::vector<std::pair<int,int> >& edges, int threadCount=0)
+{
+	return BuildUnionFind<Policy>(capacity, edges.data(), edges.size(), threadCount);
+}
+
+template <typename Policy = DefaultUnionFindPolicy>
+UnionFind<Policy> BuildUnionFindFromFile(int capacity, const std::string& path, int threadCount=0)
+{
+	return UnionFind<Policy>::FromRoots(ParallelComponentRootsFromFile(capacity, path, threadCount));
+}
+
+} /* namespace mabz */
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+
+#include <algo_lib/exceptions.h>
+
+namespace mabz { namespace percolation {
+
+// Ways of laying out the cells of an n-by-n grid in a flat array, for
+// BasicPercolation's CellIndex parameter. Each one is constructed from n and has
+//   long long Size() const;                  // number of slots, >= n*n (may be padded)
+//   long long Index(int row, int col) const; // 0-based row/col -> slot in [0, Size())
+// Slots are 64-bit so any n that fits in an int can be laid out; whether that
+// many slots fit the union-find behind the grid is up to BasicPercolation.
+// Row-major puts vertical neighbours n slots apart, so on a big grid every
+// vertical union is a cache miss; the other two keep small square patches of
+// the grid together so most neighbours share a cache line or two.
+namespace cell_index {
+
+namespace detail {
+
+// Throws IllegalArgumentException unless n > 0.
+inline void CheckSideLength(int n)
+{
+	if (n <= 0)
+	{
+		std::stringstream err;
+		err << "Grid side length must be positive for a cell layout. Got " << n;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+// Spreads the low 32 bits of x out to the even bits.
+inline std::uint64_t SpreadBits(std::uint64_t x)
+{
+	x &= 0x00000000FFFFFFFFull;
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+	x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+	x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+	x = (x | (x << 2)) & 0x3333333333333333ull;
+	x = (x | (x << 1)) & 0x5555555555555555ull;
+	return x;
+}
+
+} /* namespace detail */
+
+// The classic row * n + col.
+class RowMajor
+{
+private:
+	long long mN;
+
+public:
+	RowMajor(int n) : mN(n) { detail::CheckSideLength(n); }
+
+	long long Size() const { return mN * mN; }
+	long long Index(int row, int col) const { return row * mN + col; }
+};
+
+// Morton / Z-order: the bits of row and col interleaved, so every aligned
+// 2^k x 2^k square is contiguous. The grid is padded up to the next power of
+// two on a side, so anything just past a power of two wastes up to 3/4 of the
+// slots; padding slots are never opened.
+class Morton
+{
+private:
+	long long mSide;
+
+public:
+	Morton(int n) : mSide(1)
+	{
+		detail::CheckSideLength(n);
+		while (mSide < n) mSide <<= 1;
+	}
+
+	long long Size() const { return mSide * mSide; }
+	long long Index(int row, int col) const
+	{
+		return static_cast<long long>(detail::SpreadBits(col) | (detail::SpreadBits(row) << 1));
+	}
+};
+
+// Square TileSide x TileSide tiles, each stored row-major, tiles in row-major
+// order. With the default 16 x 16 ints each tile row is one 64 byte cache line
+// and the whole tile is 1KB. The grid is padded to a whole number of tiles.
+template <int TileSide = 16>
+class BlockedTiles
+{
+private:
+	static_assert(TileSide > 0 && (TileSide & (TileSide - 1)) == 0, "TileSide must be a power of two");
+
+	static constexpr int Log2(int x) { return x > 1 ? 1 + Log2(x / 2) : 0; }
+	static constexpr int kShift{Log2(TileSide)};
+	static constexpr int kMask{TileSide - 1};
+
+	long long mTilesPerRow;
+
+public:
+	BlockedTiles(int n) : mTilesPerRow(n > 0 ? (static_cast<long long>(n) + kMask) >> kShift : 0)
+	{
+		detail::CheckSideLength(n);
+	}
+
+	long long Size() const { return (mTilesPerRow * mTilesPerRow) << (2 * kShift); }
+	long long Index(int row, int col) const
+	{
+		const long long tile{(row >> kShift) * mTilesPerRow + (col >> kShift)};
+		return (tile << (2 * kShift)) + ((row & kMask) << kShift) + (col & kMask);
+	}
+};
+
+} /* namespace cell_index */
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz {
+
+// Weighted quick-union with path halving in a single array of one index-sized
+// word per site, instead of UnionFind's separate parent and size arrays:
+//  - entry >= 0: the index of the site's parent.
+//  - entry < 0:  the site is a root, and -entry is the size of its tree.
+// Index picks the word size, e.g. std::uint16_t for small problems and
+// std::uint64_t for more than 2^31 sites. Because one bit is spent telling
+// roots from children, capacity is limited to the max of the signed type of the
+// same width (32767 for 16 bit).
+template <typename Index = std::uint32_t>
+class CompactUnionFind
+{
+public:
+	using index_type = Index;
+
+private:
+	static_assert(std::is_integral<Index>::value, "CompactUnionFind needs an integral index type.");
+	using Entry = typename std::make_signed<Index>::type;
+
+	Index mCapacity;
+	Entry* mEntries{nullptr};
+
+	void CheckArrayBounds(Index i) const
+	{
+		// also catches negative values of signed index types.
+		if (static_cast<std::uint64_t>(i) >= static_cast<std::uint64_t>(mCapacity))
+		{
+			ThrowIndexOutOfRange(static_cast<long long>(i), static_cast<long long>(mCapacity));
+		}
+	}
+
+	Index GetRoot(Index i) const
+	{
+		// path halving: point every other node at its grandparent on the way up.
+		while (mEntries[i] >= 0)
+		{
+			const Entry parent{mEntries[i]};
+			if (mEntries[parent] >= 0) mEntries[i] = mEntries[parent];
+			i = static_cast<Index>(mEntries[i]);
+		}
+		return i;
+	}
+
+public:
+	static constexpr std::uint64_t MaxCapacity() { return static_cast<std::uint64_t>(std::numeric_limits<Entry>::max()); }
+
+	CompactUnionFind(Index capacity)
+		: mCapacity(capacity)
+	{
+		if (capacity < 0 || static_cast<std::uint64_t>(capacity) > MaxCapacity())
+		{
+			std::stringstream err;
+			err << "CompactUnionFind capacity must be between 0 and " << MaxCapacity()
+				<< " for this index type. Instead got " << static_cast<long long>(capacity);
+			throw mabz::IllegalArgumentException(err.str());
+		}
+		mEntries = new Entry[static_cast<std::size_t>(capacity)];
+		Reset();
+	}
+
+	void Reset()
+	{
+		for (Index i = 0; i < mCapacity; i++)
+		{
+			mEntries[i] = -1;
+		}
+	}
+	~CompactUnionFind() { delete[] mEntries; }
+
+	CompactUnionFind() = delete;
+	CompactUnionFind(const CompactUnionFind&) = delete;
+	CompactUnionFind(CompactUnionFind&&) = delete;
+
+	Index Capacity() const { return mCapacity; }
+
+	// Number of bytes used for the sites themselves.
+	std::size_t MemoryUsage() const { return static_cast<std::size_t>(mCapacity) * sizeof(Entry); }
+
+	Index Find(Index i) const
+	{
+		CheckArrayBounds(i);
+		return GetRoot(i);
+	}
+
+	// number of sites in the same component as i.
+	Index ComponentSize(Index i) const
+	{
+		CheckArrayBounds(i);
+		return static_cast<Index>(-mEntries[GetRoot(i)]);
+	}
+
+	void Union(Index a, Index b)
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		Index rootOfA{GetRoot(a)};
+		Index rootOfB{GetRoot(b)};
+
+		if (rootOfA == rootOfB) return;
+
+		// link the root of the smaller tree to the root of the larger tree.
+		// (sizes are stored negated, so "more negative" is bigger.)
+		if (mEntries[rootOfA] < mEntries[rootOfB])
+		{
+			const Index swapVal{rootOfA};
+			rootOfA = rootOfB;
+			rootOfB = swapVal;
+		}
+		mEntries[rootOfB] += mEntries[rootOfA];
+		mEntries[rootOfA] = static_cast<Entry>(rootOfB);
+	}
+
+	bool Connected(Index a, Index b) const
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		return GetRoot(a) == GetRoot(b);
+	}
+};
+
+} /* namespace mabz */
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <algo_lib/union_find.h>
+
+namespace mabz {
+
+// Union-find that any number of threads may call Union and Connected on at once.
+// No locks: roots are linked with a single compare-and-swap, and finds shorten
+// paths with CAS-based path halving which only ever moves a node's parent
+// closer to its root (Jayanti & Tarjan, "A Randomized Concurrent Algorithm
+// for Disjoint Set Union", 2016). Linking is by a fixed pseudo-random priority
+// rather than by size, so no per-root bookkeeping has to be kept consistent
+// with the parent pointers; it gives the same expected logarithmic depth.
+//
+// Connected is linearizable in the manner of Anderson & Woll: if the two roots
+// differ, it re-checks that the first one is still a root before answering false.
+// Reset is NOT safe to call while other threads are using the structure.
+class ConcurrentUnionFind
+{
+private:
+	int mCapacity;
+	std::atomic<int>* mRoots{nullptr};
+
+	void CheckArrayBounds(int i) const
+	{
+		if (i < 0 || i >= mCapacity) ThrowIndexOutOfRange(i, mCapacity);
+	}
+
+	// Multiplication by an odd constant is a bijection on 32 bits, so no two
+	// sites share a priority and linking never has to break a tie.
+	static std::uint32_t Priority(int i) { return static_cast<std::uint32_t>(i) * 0x9E3779B1u; }
+
+	int GetRoot(int i) const
+	{
+		int parent{mRoots[i].load(std::memory_order_acquire)};
+		while (parent != i)
+		{
+			const int grandparent{mRoots[parent].load(std::memory_order_acquire)};
+			if (grandparent != parent)
+			{
+				// failure just means someone else already moved i further up.
+				mRoots[i].compare_exchange_weak(parent, grandparent,
+					std::memory_order_release, std::memory_order_relaxed);
+			}
+			i = grandparent;
+			parent = mRoots[i].load(std::memory_order_acquire);
+		}
+		return i;
+	}
+
+public:
+	ConcurrentUnionFind(int capacity)
+		: mCapacity(capacity)
+		, mRoots(new std::atomic<int>[capacity])
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		for (int i = 0; i < mCapacity; i++)
+		{
+			mRoots[i].store(i, std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+	~ConcurrentUnionFind() { delete[] mRoots; }
+
+	ConcurrentUnionFind() = delete;
+	ConcurrentUnionFind(const ConcurrentUnionFind&) = delete;
+	ConcurrentUnionFind(ConcurrentUnionFind&&) = delete;
+
+	int Capacity() const { return mCapacity; }
+
+	// Current root of i. Under concurrent Unions this may be stale by the time
+	// the caller looks at it; use Connected for a consistent answer.
+	int Find(int i) const
+	{
+		CheckArrayBounds(i);
+		return GetRoot(i);
+	}
+
+	void Union(int a, int b)
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		while (true)
+		{
+			int rootOfA{GetRoot(a)};
+			int rootOfB{GetRoot(b)};
+
+			if (rootOfA == rootOfB) return;
+
+			// link the root with the lower priority under the one with the higher.
+			if (Priority(rootOfA) > Priority(rootOfB))
+			{
+				const int swapVal{rootOfA};
+				rootOfA = rootOfB;
+				rootOfB = swapVal;
+			}
+
+			// only succeeds if rootOfA is still a root; otherwise someone linked
+			// it first and we go round again from the new roots.
+			int expected{rootOfA};
+			if (mRoots[rootOfA].compare_exchange_strong(expected, rootOfB,
+				std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				return;
+			}
+		}
+	}
+
+	bool Connected(int a, int b) const
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		while (true)
+		{
+			const int rootOfA{GetRoot(a)};
+			const int rootOfB{GetRoot(b)};
+
+			if (rootOfA == rootOfB) return true;
+
+			// if rootOfA is still a root then a and b were in different sets at
+			// the moment we found rootOfB.
+			if (mRoots[rootOfA].load(std::memory_order_acquire) == rootOfA) return false;
+		}
+	}
+};
+
+} /* namespace mabz */
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mabz {
+
+// On-disk CSR graph format, all native-endian:
+//   CsrGraphFileHeader, then mVertices + 1 uint64 offsets, then mAdjacencies
+//   int32 neighbours.
+struct CsrGraphFileHeader
+{
+	char mMagic[8];
+	std::uint32_t mVersion;
+	std::uint32_t mReserved;
+	std::uint64_t mVertices;
+	std::uint64_t mAdjacencies;
+};
+
+// Undirected graph in compressed sparse row form: the neighbours of vertex v
+// are mNeighbours[mOffsets[v] .. mOffsets[v+1]). Every edge must appear in
+// both of its endpoints' rows; FromEdges takes care of that. Vertices are
+// numbered 0..VertexCount()-1.
+class CsrGraph
+{
+private:
+	std::vector<std::uint64_t> mOffsets;
+	std::vector<int> mNeighbours;
+
+	// Throws IllegalArgumentException unless offsets start at 0, never
+	// decrease, end at neighbours.size(), and every neighbour is a vertex.
+	static void Validate(const std::vector<std::uint64_t>& offsets, const std::vector<int>& neighbours);
+
+public:
+	// The empty graph.
+	CsrGraph() : mOffsets(1, 0) {}
+
+	// Takes the arrays as they are, after validating them.
+	CsrGraph(std::vector<std::uint64_t> offsets, std::vector<int> neighbours);
+
+	// Builds the CSR arrays for vertices 0..vertexCount-1 from an undirected
+	// edge list, each edge going into both endpoints' rows (a self loop goes in
+	// once). O(vertices + edges), no sorting.
+	static CsrGraph FromEdges(int vertexCount, const std::vector<std::pair<int,int> >& edges);
+
+	// Reads / writes the binary format above. Loading is one memory mapping,
+	// two copies and a validation pass, so it runs at memory bandwidth.
+	// Throws mabz::FileError for IO errors or a malformed file.
+	static CsrGraph Load(const std::string& path);
+	void Save(const std::string& path) const;
+
+	int VertexCount() const { return static_cast<int>(mOffsets.size() - 1); }
+	std::uint64_t AdjacencyCount() const { return mNeighbours.size(); }
+
+	// Unchecked: v must be a vertex.
+	int Degree(int v) const { return static_cast<int>(mOffsets[v+1] - mOffsets[v]); }
+	const int* NeighboursBegin(int v) const { return mNeighbours.data() + mOffsets[v]; }
+	const int* NeighboursEnd(int v) const { return mNeighbours.data() + mOffsets[v+1]; }
+
+	const std::vector<std::uint64_t>& Offsets() const { return mOffsets; }
+	const std::vector<int>& Neighbours() const { return mNeighbours; }
+};
+
+} /* namespace mabz */
@@ -22,6 +22,7 @@ CUSTOM(UnexpectedMethodCall)
 CUSTOM(Unreachable)
 CUSTOM(EmptyContainer)
 CUSTOM(IllegalIteratorOp)
+CUSTOM(FileError)
 
 #undef CUSTOM
 
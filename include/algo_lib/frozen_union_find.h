@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace mabz {
+
+[[noreturn]] void ThrowIndexOutOfRange(long long i, long long capacity);
+
+// Immutable snapshot of a union-find in which every site's entry is directly the
+// label (root) of its component, so Connected is two loads and a compare. Made
+// by UnionFind::Freeze() once a build phase is over.
+// Nothing is ever written after construction, so any number of threads may
+// query the same instance at once without synchronization.
+class FrozenUnionFind
+{
+private:
+	std::vector<int> mLabels;
+	int mComponentCount{0};
+
+	void CheckArrayBounds(int i) const
+	{
+		if (i < 0 || i >= Capacity()) ThrowIndexOutOfRange(i, Capacity());
+	}
+
+	// Branch-free check of a whole batch: one unsigned compare per index,
+	// or-ed together, which vectorizes.
+	void CheckBatchBounds(const int* sites, std::size_t count) const
+	{
+		const unsigned capacity = static_cast<unsigned>(Capacity());
+		bool anyOutOfRange{false};
+		for (std::size_t i = 0; i < count; i++)
+		{
+			anyOutOfRange |= static_cast<unsigned>(sites[i]) >= capacity;
+		}
+		if (!anyOutOfRange) return;
+		for (std::size_t i = 0; i < count; i++) CheckArrayBounds(sites[i]);
+	}
+
+public:
+	// labels[i] is the label of site i's component; equal labels mean connected.
+	FrozenUnionFind(std::vector<int> labels, int componentCount)
+		: mLabels(std::move(labels))
+		, mComponentCount(componentCount)
+	{}
+
+	int Capacity() const { return static_cast<int>(mLabels.size()); }
+	int ComponentCount() const { return mComponentCount; }
+
+	int Label(int i) const
+	{
+		CheckArrayBounds(i);
+		return mLabels[i];
+	}
+
+	const std::vector<int>& Labels() const { return mLabels; }
+
+	bool Connected(int a, int b) const
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+		return mLabels[a] == mLabels[b];
+	}
+
+	// outConnected[i] = Connected(a[i], b[i]) for i in [0, count).
+	// Struct-of-arrays so that, after one bounds pass over each input, the main
+	// loop is a plain gather-and-compare that compilers vectorize (with AVX2
+	// gathers where enabled). Throws IndexOutOfRange, having written nothing, if
+	// any index is bad.
+	void ConnectedBatch(const int* a, const int* b, std::size_t count, bool* outConnected) const
+	{
+		CheckBatchBounds(a, count);
+		CheckBatchBounds(b, count);
+
+		const int* labels = mLabels.data();
+		for (std::size_t i = 0; i < count; i++)
+		{
+			outConnected[i] = labels[a[i]] == labels[b[i]];
+		}
+	}
+
+	// Same, for pairs laid out as UnionFind::ConnectedBatch takes them.
+	void ConnectedBatch(const std::pair<int,int>* pairs, std::size_t count, bool* outConnected) const
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			CheckArrayBounds(pairs[i].first);
+			CheckArrayBounds(pairs[i].second);
+		}
+
+		const int* labels = mLabels.data();
+		for (std::size_t i = 0; i < count; i++)
+		{
+			outConnected[i] = labels[pairs[i].first] == labels[pairs[i].second];
+		}
+	}
+};
+
+} /* namespace mabz */
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <algo_lib/bit_grid.h>
+#include <algo_lib/csr_graph.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz { namespace percolation {
+
+// Site percolation on an arbitrary undirected graph, with the same API as
+// Percolation: vertices start blocked, Open them one at a time, and the system
+// percolates once an open path joins some source vertex to some sink vertex.
+// The source and sink sets play the part of the top and bottom rows, each
+// joined through one virtual node. Vertices are 0-based, as in the CsrGraph.
+template <typename UnionFindPolicy = mabz::DefaultUnionFindPolicy>
+class BasicGraphPercolation
+{
+private:
+	CsrGraph mGraph;
+	// node 0 is the source node, vertex v is node 1 + v, and node
+	// VertexCount() + 1 is the sink node.
+	mabz::UnionFind<UnionFindPolicy> mConnections;
+	// one bit per vertex in a single row.
+	mabz::BitGrid mOpen;
+	mabz::BitGrid mIsSource;
+	mabz::BitGrid mIsSink;
+
+	int SinkNode() const { return mGraph.VertexCount() + 1; }
+
+	// Throw IllegalArgumentException if not a vertex.
+	void CheckVertex(int v) const;
+
+public:
+	// Takes ownership of the graph; sources and sinks may overlap (such a vertex
+	// percolates on its own once open) and may repeat.
+	BasicGraphPercolation(CsrGraph graph, const std::vector<int>& sources, const std::vector<int>& sinks);
+
+	const CsrGraph& Graph() const { return mGraph; }
+	int VertexCount() const { return mGraph.VertexCount(); }
+
+	// Lets you clear everything and start again if you want.
+	void ResetGrid();
+
+	// opens vertex v if it is not open already
+	void Open(int v);
+
+	bool IsOpen(int v) const;
+
+	// is v joined to an open source vertex through open vertices?
+	bool IsFull(int v) const;
+
+	int GetNumberOfOpenSites() const { return static_cast<int>(mOpen.Count()); }
+
+	bool DoesPercolate() const { return mConnections.Connected(0, SinkNode()); }
+};
+
+using GraphPercolation = BasicGraphPercolation<>;
+
+template <typename UnionFindPolicy>
+BasicGraphPercolation<UnionFindPolicy>::BasicGraphPercolation(CsrGraph graph,
+	const std::vector<int>& sources, const std::vector<int>& sinks)
+	: mGraph(std::move(graph))
+	, mConnections(mGraph.VertexCount() + 2)
+	, mOpen(1, mGraph.VertexCount())
+	, mIsSource(1, mGraph.VertexCount())
+	, mIsSink(1, mGraph.VertexCount())
+{
+	for (int v : sources)
+	{
+		CheckVertex(v);
+		mIsSource.Set(0, v);
+	}
+	for (int v : sinks)
+	{
+		CheckVertex(v);
+		mIsSink.Set(0, v);
+	}
+}
+
+template <typename UnionFindPolicy>
+void BasicGraphPercolation<UnionFindPolicy>::CheckVertex(int v) const
+{
+	if (v < 0 || v >= mGraph.VertexCount())
+	{
+		std::stringstream err;
+		err << "Vertex must be between 0 and " << mGraph.VertexCount() << " exclusive. Got " << v;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+template <typename UnionFindPolicy>
+void BasicGraphPercolation<UnionFindPolicy>::ResetGrid()
+{
+	mConnections.Reset();
+	mOpen.ClearAll();
+}
+
+template <typename UnionFindPolicy>
+void BasicGraphPercolation<UnionFindPolicy>::Open(int v)
+{
+	CheckVertex(v);
+	if (!mOpen.Set(0, v)) return;
+
+	const int node{1 + v};
+	for (const int* it = mGraph.NeighboursBegin(v); it != mGraph.NeighboursEnd(v); ++it)
+	{
+		if (mOpen.Get(0, *it))
+		{
+			mConnections.Union(node, 1 + *it);
+		}
+	}
+	if (mIsSource.Get(0, v)) mConnections.Union(node, 0);
+	if (mIsSink.Get(0, v)) mConnections.Union(node, SinkNode());
+}
+
+template <typename UnionFindPolicy>
+bool BasicGraphPercolation<UnionFindPolicy>::IsOpen(int v) const
+{
+	CheckVertex(v);
+	return mOpen.Get(0, v);
+}
+
+template <typename UnionFindPolicy>
+bool BasicGraphPercolation<UnionFindPolicy>::IsFull(int v) const
+{
+	CheckVertex(v);
+	return mConnections.Connected(0, 1 + v);
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz {
+
+// Weighted quick-union with path halving that can keep adding sites.
+// Sites live in fixed-size chunks which, once allocated, never move: growing
+// only appends chunks (and a pointer to each one in a small directory), so
+// nothing already stored is ever copied and no site's storage is invalidated.
+// Site i lives at chunk i >> kChunkShift, slot i & kChunkMask.
+class GrowableUnionFind
+{
+private:
+	static constexpr int kChunkShift{12};
+	static constexpr int kChunkSites{1 << kChunkShift};
+	static constexpr int kChunkMask{kChunkSites - 1};
+
+	// Parent and size side by side, so a Union touches one cache line per root.
+	struct Site
+	{
+		int mParent;
+		int mTreeSize;
+	};
+
+	std::vector<std::unique_ptr<Site[]> > mChunks;
+	int mSize{0};
+	int mComponentCount{0};
+
+	Site& At(int i) const { return mChunks[i >> kChunkShift][i & kChunkMask]; }
+
+	void CheckArrayBounds(int i) const
+	{
+		if (i < 0 || i >= mSize) ThrowIndexOutOfRange(i, mSize);
+	}
+
+	int GetRoot(int i) const
+	{
+		// path halving: point every other node at its grandparent on the way up.
+		while (i != At(i).mParent)
+		{
+			Site& site = At(i);
+			site.mParent = At(site.mParent).mParent;
+			i = site.mParent;
+		}
+		return i;
+	}
+
+public:
+	// Starts with initialSize singleton sites.
+	GrowableUnionFind(int initialSize=0)
+	{
+		if (initialSize < 0)
+		{
+			std::stringstream err;
+			err << "GrowableUnionFind initial size must not be negative. Instead got " << initialSize;
+			throw mabz::IllegalArgumentException(err.str());
+		}
+		Reserve(initialSize);
+		for (int i = 0; i < initialSize; i++) AddSite();
+	}
+
+	GrowableUnionFind(const GrowableUnionFind&) = delete;
+	GrowableUnionFind& operator = (const GrowableUnionFind&) = delete;
+
+	// A moved-from GrowableUnionFind is empty (no sites, no chunks) and can be
+	// grown again.
+	GrowableUnionFind(GrowableUnionFind&& other) noexcept
+		: mChunks(std::move(other.mChunks))
+		, mSize(other.mSize)
+		, mComponentCount(other.mComponentCount)
+	{
+		other.mChunks.clear();
+		other.mSize = 0;
+		other.mComponentCount = 0;
+	}
+
+	GrowableUnionFind& operator = (GrowableUnionFind&& other) noexcept
+	{
+		if (this != &other)
+		{
+			mChunks = std::move(other.mChunks);
+			mSize = other.mSize;
+			mComponentCount = other.mComponentCount;
+			other.mChunks.clear();
+			other.mSize = 0;
+			other.mComponentCount = 0;
+		}
+		return *this;
+	}
+
+	// Number of sites added so far.
+	int Size() const { return mSize; }
+
+	// Number of sites that can be added before another chunk has to be allocated.
+	int Capacity() const { return static_cast<int>(mChunks.size()) * kChunkSites; }
+
+	// Allocates chunks up front so that the next (capacity - Size()) AddSite calls
+	// don't allocate. Never shrinks.
+	void Reserve(int capacity)
+	{
+		while (Capacity() < capacity)
+		{
+			mChunks.emplace_back(new Site[kChunkSites]);
+		}
+	}
+
+	// Adds a new singleton site and returns its index.
+	int AddSite()
+	{
+		if (mSize == Capacity()) Reserve(mSize + 1);
+		const int i{mSize++};
+		At(i) = Site{i, 1};
+		mComponentCount++;
+		return i;
+	}
+
+	// Makes every site a singleton again, keeping them all (and the chunks).
+	void Reset()
+	{
+		for (int i = 0; i < mSize; i++) At(i) = Site{i, 1};
+		mComponentCount = mSize;
+	}
+
+	int ComponentCount() const { return mComponentCount; }
+
+	int Find(int i) const
+	{
+		CheckArrayBounds(i);
+		return GetRoot(i);
+	}
+
+	int ComponentSize(int i) const { return At(Find(i)).mTreeSize; }
+
+	void Union(int a, int b)
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		int rootOfA{GetRoot(a)};
+		int rootOfB{GetRoot(b)};
+
+		if (rootOfA == rootOfB) return;
+
+		// link the root of the smaller tree to the root of the larger tree
+		if (At(rootOfA).mTreeSize > At(rootOfB).mTreeSize) std::swap(rootOfA, rootOfB);
+		At(rootOfA).mParent = rootOfB;
+		At(rootOfB).mTreeSize += At(rootOfA).mTreeSize;
+		mComponentCount--;
+	}
+
+	bool Connected(int a, int b) const
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		return GetRoot(a) == GetRoot(b);
+	}
+};
+
+} /* namespace mabz */
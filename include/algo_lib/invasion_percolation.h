@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <algo_lib/bit_grid.h>
+
+namespace mabz { namespace percolation {
+
+// Invasion percolation on an n-by-n grid. Every cell has an independent
+// uniform [0, 1) weight; the invading cluster starts as the whole top row's
+// frontier and repeatedly invades the lowest weight cell on its frontier until
+// it takes a bottom row cell. The largest weight it had to invade on the way
+// is the trial's threshold estimate, which tends to the site percolation
+// threshold as n grows.
+//
+// The frontier is a binary min-heap, and weights are only drawn for cells as
+// they join the frontier, so a run touches just the invaded cluster and its
+// boundary rather than all n^2 cells. The open state uses the same one bit per
+// cell BitGrid as Percolation; rows and cols are 1-based in queries.
+class InvasionPercolation
+{
+private:
+	struct FrontierCell
+	{
+		double mWeight;
+		int mCell;
+	};
+
+	int mN;
+	// cells invaded so far, and cells invaded or on the frontier.
+	mabz::BitGrid mInvaded;
+	mabz::BitGrid mSeen;
+	// min-heap on weight, kept between runs so its storage gets reused.
+	std::vector<FrontierCell> mFrontier;
+	double mThreshold{0};
+
+public:
+	// Throws IllegalArgumentException unless n > 0.
+	InvasionPercolation(int n);
+
+	int N() const { return mN; }
+
+	// Runs one invasion from scratch with weights drawn from a generator
+	// seeded with seed, and returns its threshold.
+	double Run(std::uint64_t seed);
+
+	// Results of the last Run (all zero before the first).
+	double Threshold() const { return mThreshold; }
+	long long GetNumberOfInvadedSites() const { return mInvaded.Count(); }
+	// invaded sites plus those left on the frontier: every cell a weight was drawn for.
+	long long GetNumberOfTouchedSites() const { return mSeen.Count(); }
+	bool IsInvaded(int row, int col) const;
+};
+
+class InvasionPercolationStats
+{
+private:
+	double mMean;
+	double mStdev;
+	double mConfidenceLow;
+	double mConfidenceHigh;
+
+public:
+	// perform independent invasions on an n-by-n grid, trial i seeded with i.
+	InvasionPercolationStats(int n, int trials);
+
+	// sample mean of percolation threshold
+	double Mean() const { return mMean; }
+
+	// sample standard deviation of percolation threshold
+	double Stdev() const { return mStdev; }
+
+	// low endpoint of 95% confidence interval
+	double ConfidenceLow() const { return mConfidenceLow; }
+
+	// high endpoint of 95% confidence interval
+	double ConfidenceHigh() const { return mConfidenceHigh; }
+};
+
+} /* namespace percolation */
+} /* namespace mabz */
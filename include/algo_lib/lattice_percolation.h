@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <sstream>
+#include <utility>
+
+#include <algo_lib/bit_grid.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz { namespace percolation {
+
+// Lattice topologies for LatticePercolation. Each one has
+//   static constexpr int kDims;       // number of coordinates per site
+//   static constexpr int kNeighbours; // neighbours of an interior site
+//   static constexpr std::array<std::array<int, kDims>, kNeighbours> kOffsets;
+// where kOffsets are the coordinate deltas from a site to its neighbours, and
+// must be symmetric (if d is in there, so is -d). Everything is known at
+// compile time, so the neighbour loop is expanded once per offset and comes
+// down to the same handful of compares and unions as the hand written 2D code
+// in BasicPercolation.
+namespace lattice {
+
+namespace detail {
+
+// The 2 * Dims offsets of +/-1 along each axis.
+template <int Dims>
+constexpr std::array<std::array<int, Dims>, 2 * Dims> AxisOffsets()
+{
+	std::array<std::array<int, Dims>, 2 * Dims> offsets{};
+	for (int d = 0; d < Dims; d++)
+	{
+		offsets[2*d][d] = -1;
+		offsets[2*d + 1][d] = 1;
+	}
+	return offsets;
+}
+
+} /* namespace detail */
+
+// Simple (hyper)cubic lattice: neighbours are +/-1 along each axis.
+template <int Dims>
+struct Hypercubic
+{
+	static_assert(Dims >= 1, "Need at least one dimension");
+	static constexpr int kDims{Dims};
+	static constexpr int kNeighbours{2 * Dims};
+	static constexpr std::array<std::array<int, kDims>, kNeighbours> kOffsets{detail::AxisOffsets<Dims>()};
+};
+
+// 4 neighbours, same as Percolation. Site threshold ~0.5927.
+using Square = Hypercubic<2>;
+// 6 neighbours. Site threshold ~0.3116.
+using Cubic = Hypercubic<3>;
+
+// Triangular lattice stored on a square grid: the square neighbours plus one
+// diagonal, (-1,-1) and (+1,+1). Every site has 6 neighbours, so this is also
+// site percolation on a grid of hexagonal cells. Site threshold is exactly 1/2.
+struct Triangular
+{
+	static constexpr int kDims{2};
+	static constexpr int kNeighbours{6};
+	static constexpr std::array<std::array<int, kDims>, kNeighbours> kOffsets{{
+		{{-1, 0}}, {{1, 0}}, {{0, -1}}, {{0, 1}}, {{-1, -1}}, {{1, 1}}
+	}};
+};
+
+} /* namespace lattice */
+
+// Site percolation on a box of a Lattice, with the extent of each axis set at
+// construction (so m x n rectangles, l x m x n boxes, ...). The first axis is
+// the percolating direction: the "top" is coordinate 1 along it and the
+// "bottom" is its extent. With Periodic, every OTHER axis wraps around
+// (a cylinder in 2D, a 3-torus with open ends in 3D); the percolating axis
+// never wraps, or top and bottom would simply be neighbours.
+//
+// Coordinates are 1-based, matching Percolation. Like Percolation, one virtual
+// node joins the top face and another the bottom face, so IsFull can show
+// "backwash" through the bottom once the system percolates.
+template <typename Lattice, bool Periodic = false,
+	typename UnionFindPolicy = mabz::DefaultUnionFindPolicy>
+class LatticePercolation
+{
+public:
+	static constexpr int kDims{Lattice::kDims};
+	using Coords = std::array<int, kDims>;
+
+private:
+	Coords mExtents;
+	// row-major: the last axis varies fastest.
+	Coords mStrides;
+	int mSites;
+	// site number difference to each neighbour, before any wrapping.
+	std::array<int, Lattice::kNeighbours> mSiteOffsets;
+
+	// node 0 is the entry node, site s is node 1 + s, node mSites + 1 is the exit.
+	mabz::UnionFind<UnionFindPolicy> mConnections;
+	// open state of site s is bit s of the one and only row.
+	mabz::BitGrid mOpen;
+
+	// Throws IllegalArgumentException unless every extent is positive and the
+	// number of sites (plus 2) fits in an int. Otherwise returns that number.
+	static int CheckedSiteCount(const Coords& extents);
+
+	// Throw IllegalArgumentException if out of bounds (1-extent inclusive).
+	void CheckBounds(const Coords& coords) const;
+
+	// site number of 0-based coordinates.
+	int SiteOf(const Coords& zeroBased) const
+	{
+		int site{0};
+		for (int d = 0; d < kDims; d++) site += zeroBased[d] * mStrides[d];
+		return site;
+	}
+
+	// Unions an open site with its K'th neighbour if that's inside and open.
+	template <int K>
+	void ConnectNeighbour(const Coords& zeroBased, int site);
+	template <std::size_t... Ks>
+	void ConnectNeighbours(const Coords& zeroBased, int site, std::index_sequence<Ks...>);
+
+	// To be called after opening a previously closed site, with its 0-based
+	// coordinates.
+	void CreateNewConnections(const Coords& zeroBased, int site);
+
+public:
+	// all sites initially blocked.
+	LatticePercolation(const Coords& extents);
+
+	const Coords& Extents() const { return mExtents; }
+	int Sites() const { return mSites; }
+
+	// 1-based coordinates of site number 0..Sites()-1 (row-major order), handy
+	// for opening sites in a shuffled order.
+	Coords SiteCoords(int site) const;
+
+	void ResetGrid();
+
+	// opens the site if it is not open already
+	void Open(const Coords& coords);
+	bool IsOpen(const Coords& coords) const;
+	// connected to an open site on the top face?
+	bool IsFull(const Coords& coords) const;
+
+	long long GetNumberOfOpenSites() const { return mOpen.Count(); }
+
+	// is some open site on the top face connected to one on the bottom face?
+	bool DoesPercolate() const { return mConnections.Connected(0, mSites + 1); }
+};
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+int LatticePercolation<Lattice, Periodic, UnionFindPolicy>::CheckedSiteCount(const Coords& extents)
+{
+	long long sites{1};
+	for (int d = 0; d < kDims; d++)
+	{
+		if (extents[d] <= 0 || sites * extents[d] > INT_MAX - 2)
+		{
+			std::stringstream err;
+			err << "Lattice extents must be positive and have fewer than " << INT_MAX - 2
+			    << " sites in total. Got extent " << extents[d] << " for axis " << d;
+			throw mabz::IllegalArgumentException(err.str());
+		}
+		sites *= extents[d];
+	}
+	return static_cast<int>(sites);
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+LatticePercolation<Lattice, Periodic, UnionFindPolicy>::LatticePercolation(const Coords& extents)
+	: mExtents(extents)
+	, mSites(CheckedSiteCount(extents))
+	, mConnections(mSites + 2)
+	, mOpen(1, mSites)
+{
+	int stride{1};
+	for (int d = kDims - 1; d >= 0; d--)
+	{
+		mStrides[d] = stride;
+		stride *= mExtents[d];
+	}
+	for (int k = 0; k < Lattice::kNeighbours; k++)
+	{
+		mSiteOffsets[k] = 0;
+		for (int d = 0; d < kDims; d++) mSiteOffsets[k] += Lattice::kOffsets[k][d] * mStrides[d];
+	}
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+void LatticePercolation<Lattice, Periodic, UnionFindPolicy>::CheckBounds(const Coords& coords) const
+{
+	for (int d = 0; d < kDims; d++)
+	{
+		if (coords[d] < 1 || coords[d] > mExtents[d])
+		{
+			std::stringstream err;
+			err << "Coordinate " << d << " must be between 1 and " << mExtents[d]
+			    << " inclusive. Got " << coords[d];
+			throw mabz::IllegalArgumentException(err.str());
+		}
+	}
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+template <int K>
+void LatticePercolation<Lattice, Periodic, UnionFindPolicy>::ConnectNeighbour(const Coords& zeroBased, int site)
+{
+	// only the axes this offset moves along can leave the box; with K fixed the
+	// compiler drops the rest.
+	int other{site + mSiteOffsets[K]};
+	for (int d = 0; d < kDims; d++)
+	{
+		const int offset{Lattice::kOffsets[K][d]};
+		if (offset == 0) continue;
+
+		const int coord{zeroBased[d] + offset};
+		if (coord < 0 || coord >= mExtents[d])
+		{
+			if (!Periodic || d == 0) return;
+			other += (coord < 0 ? mExtents[d] : -mExtents[d]) * mStrides[d];
+		}
+	}
+
+	if (mOpen.Get(0, other))
+	{
+		mConnections.Union(1 + site, 1 + other);
+	}
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+template <std::size_t... Ks>
+void LatticePercolation<Lattice, Periodic, UnionFindPolicy>::ConnectNeighbours(const Coords& zeroBased, int site,
+	std::index_sequence<Ks...>)
+{
+	(ConnectNeighbour<static_cast<int>(Ks)>(zeroBased, site), ...);
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+void LatticePercolation<Lattice, Periodic, UnionFindPolicy>::CreateNewConnections(const Coords& zeroBased, int site)
+{
+	const int node{1 + site};
+	ConnectNeighbours(zeroBased, site, std::make_index_sequence<Lattice::kNeighbours>());
+
+	// on the top face; connect to the entry node!
+	if (zeroBased[0] == 0)
+	{
+		mConnections.Union(node, 0);
+	}
+	// on the bottom face; connect to the exit node!
+	if (zeroBased[0] == mExtents[0] - 1)
+	{
+		mConnections.Union(node, mSites + 1);
+	}
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+typename LatticePercolation<Lattice, Periodic, UnionFindPolicy>::Coords
+LatticePercolation<Lattice, Periodic, UnionFindPolicy>::SiteCoords(int site) const
+{
+	if (site < 0 || site >= mSites)
+	{
+		std::stringstream err;
+		err << "Site number must be between 0 and " << mSites - 1 << " inclusive. Got " << site;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	Coords coords;
+	for (int d = 0; d < kDims; d++)
+	{
+		coords[d] = 1 + site / mStrides[d];
+		site %= mStrides[d];
+	}
+	return coords;
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+void LatticePercolation<Lattice, Periodic, UnionFindPolicy>::ResetGrid()
+{
+	mConnections.Reset();
+	mOpen.ClearAll();
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+void LatticePercolation<Lattice, Periodic, UnionFindPolicy>::Open(const Coords& coords)
+{
+	CheckBounds(coords);
+	Coords zeroBased;
+	for (int d = 0; d < kDims; d++) zeroBased[d] = coords[d] - 1;
+
+	const int site{SiteOf(zeroBased)};
+	if (mOpen.Set(0, site))
+	{
+		CreateNewConnections(zeroBased, site);
+	}
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+bool LatticePercolation<Lattice, Periodic, UnionFindPolicy>::IsOpen(const Coords& coords) const
+{
+	CheckBounds(coords);
+	Coords zeroBased;
+	for (int d = 0; d < kDims; d++) zeroBased[d] = coords[d] - 1;
+	return mOpen.Get(0, SiteOf(zeroBased));
+}
+
+template <typename Lattice, bool Periodic, typename UnionFindPolicy>
+bool LatticePercolation<Lattice, Periodic, UnionFindPolicy>::IsFull(const Coords& coords) const
+{
+	CheckBounds(coords);
+	Coords zeroBased;
+	for (int d = 0; d < kDims; d++) zeroBased[d] = coords[d] - 1;
+	return mConnections.Connected(0, 1 + SiteOf(zeroBased));
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
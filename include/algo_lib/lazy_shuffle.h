@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/rng.h>
+
+namespace mabz {
+
+// Hands out 0..size-1 in a uniformly random order on demand, doing the
+// Fisher-Yates steps lazily, so a caller that stops early (a percolation trial
+// stops after about 59% of the cells) never pays for shuffling the rest.
+//
+// The steps are done a block of kBlockSize at a time rather than one per
+// Next(): a tight loop of swaps keeps many of their cache misses in flight at
+// once, where interleaving single swaps with the caller's own work (even with
+// a prefetch) measured slower. Each 64-bit engine output is split into two
+// 32-bit draws for rng::Bounded32, so Engine must produce 64 uniform bits, like
+// std::mt19937_64 or the engines in rng.h.
+//
+// Rewind() puts the values back in order for another run. It is a sequential
+// O(size) pass, which beats undoing the random swaps one by one.
+//
+// Value is the integer type handed out, so a shuffle of more than INT_MAX
+// values (the cells of a LargePercolation grid) needs a 64-bit one. A step
+// whose range is past 2^32 takes a whole engine output through rng::Bounded;
+// below that Value makes no difference to the order.
+template <typename Value>
+class BasicLazyShuffle
+{
+public:
+	static_assert(std::is_integral<Value>::value && std::is_signed<Value>::value,
+		"BasicLazyShuffle needs a signed integral value type.");
+	static constexpr int kBlockSize{512};
+
+private:
+	std::vector<Value> mValues;
+	// mValues[0, mShuffled) hold the permutation so far; [mNext, mShuffled)
+	// have not been handed out yet.
+	Value mShuffled{0};
+	Value mNext{0};
+	// the upper half of the last engine output, if not used yet.
+	std::uint32_t mSpareBits{0};
+	bool mHasSpareBits{false};
+
+	template <typename Engine>
+	std::uint32_t NextBits(Engine& randEng)
+	{
+		static_assert(Engine::min() == 0 && Engine::max() == UINT64_MAX,
+			"LazyShuffle needs an engine that produces 64 uniform bits.");
+		if (mHasSpareBits)
+		{
+			mHasSpareBits = false;
+			return mSpareBits;
+		}
+		const std::uint64_t bits{randEng()};
+		mSpareBits = static_cast<std::uint32_t>(bits >> 32);
+		mHasSpareBits = true;
+		return static_cast<std::uint32_t>(bits);
+	}
+
+	template <typename Engine>
+	void ShuffleBlock(Engine& randEng)
+	{
+		const Value size{Size()};
+		const Value end{size - mShuffled > kBlockSize ? mShuffled + kBlockSize : size};
+		for (Value step = mShuffled; step < end; step++)
+		{
+			const std::uint64_t range{static_cast<std::uint64_t>(size - step)};
+			const std::uint64_t offset{range <= UINT32_MAX
+				? rng::Bounded32([&]() { return NextBits(randEng); }, static_cast<std::uint32_t>(range))
+				: rng::Bounded(randEng, range)};
+			std::swap(mValues[step], mValues[step + static_cast<Value>(offset)]);
+		}
+		mShuffled = end;
+	}
+
+public:
+	BasicLazyShuffle(Value size)
+	{
+		if (size < 0)
+		{
+			std::stringstream err;
+			err << "LazyShuffle size must not be negative. Got " << size;
+			throw mabz::IllegalArgumentException(err.str());
+		}
+		mValues.resize(static_cast<std::size_t>(size));
+		std::iota(mValues.begin(), mValues.end(), Value{0});
+	}
+
+	Value Size() const { return static_cast<Value>(mValues.size()); }
+	Value Remaining() const { return Size() - mNext; }
+
+	// The next value of the permutation. Throws UnexpectedMethodCall once all
+	// Size() values have been handed out.
+	template <typename Engine>
+	Value Next(Engine& randEng)
+	{
+		if (mNext == mShuffled)
+		{
+			if (mNext == Size())
+			{
+				throw mabz::UnexpectedMethodCall("LazyShuffle has no values left; Rewind() it first.");
+			}
+			ShuffleBlock(randEng);
+		}
+		return mValues[mNext++];
+	}
+
+	void Rewind()
+	{
+		if (mShuffled > 0) std::iota(mValues.begin(), mValues.end(), Value{0});
+		mShuffled = 0;
+		mNext = 0;
+		mHasSpareBits = false;
+	}
+};
+
+using LazyShuffle = BasicLazyShuffle<int>;
+
+} /* namespace mabz */
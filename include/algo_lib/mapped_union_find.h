@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/memory_mapped_file.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz {
+
+// On-disk union-find snapshot format, all native-endian:
+//   UnionFindSnapshotHeader, then Capacity() entries of the signed type as wide as Index.
+// Entries use the same encoding as CompactUnionFind: entry >= 0 is the parent,
+// entry < 0 marks a root whose tree has -entry sites.
+struct UnionFindSnapshotHeader
+{
+	char mMagic[8];
+	std::uint32_t mVersion;
+	// sizeof one entry, so a file can't be opened with the wrong Index width.
+	std::uint32_t mEntryBytes;
+	std::uint64_t mCapacity;
+};
+
+// Union-find living in a memory mapped snapshot file.
+// Opened read-only it is a zero-copy view: nothing is read until a query touches
+// it, nothing is ever written, so any number of threads (and processes) may call
+// Find/Connected at once. Opened writable (or freshly Created) it supports Union
+// with union by size and path halving, building the structure inside the file.
+template <typename Index = std::uint32_t>
+class MappedUnionFind
+{
+private:
+	static_assert(std::is_integral<Index>::value, "MappedUnionFind needs an integral index type.");
+	using Entry = typename std::make_signed<Index>::type;
+
+	MemoryMappedFile mFile;
+	Entry* mEntries{nullptr};
+	Index mCapacity{0};
+
+	static constexpr char kMagic[8] = {'M', 'A', 'B', 'Z', 'U', 'F', 'S', 'N'};
+	static constexpr std::uint32_t kVersion{1};
+
+	static std::size_t FileSize(std::uint64_t capacity)
+	{
+		return sizeof(UnionFindSnapshotHeader) + static_cast<std::size_t>(capacity) * sizeof(Entry);
+	}
+
+	// Checks the header against this Index type and the file size.
+	MappedUnionFind(MemoryMappedFile&& file, const std::string& path)
+		: mFile(std::move(file))
+	{
+		UnionFindSnapshotHeader header;
+		if (mFile.Size() < sizeof(header))
+		{
+			throw mabz::FileError("Too small to be a union-find snapshot: \"" + path + "\".");
+		}
+		std::memcpy(&header, mFile.Data(), sizeof(header));
+		if (std::memcmp(header.mMagic, kMagic, sizeof(kMagic)) != 0 || header.mVersion != kVersion)
+		{
+			throw mabz::FileError("Not a union-find snapshot (or an unsupported version): \"" + path + "\".");
+		}
+		if (header.mEntryBytes != sizeof(Entry) || header.mCapacity > MaxCapacity()
+			|| mFile.Size() < FileSize(header.mCapacity))
+		{
+			std::stringstream err;
+			err << "Union-find snapshot \"" << path << "\" has " << header.mCapacity << " entries of "
+				<< header.mEntryBytes << " bytes in " << mFile.Size() << " bytes, which doesn't fit "
+				<< "an index type of " << sizeof(Entry) << " bytes.";
+			throw mabz::FileError(err.str());
+		}
+
+		mCapacity = static_cast<Index>(header.mCapacity);
+		mEntries = reinterpret_cast<Entry*>(static_cast<char*>(mFile.Data()) + sizeof(header));
+	}
+
+	void CheckArrayBounds(Index i) const
+	{
+		if (static_cast<std::uint64_t>(i) >= static_cast<std::uint64_t>(mCapacity))
+		{
+			ThrowIndexOutOfRange(static_cast<long long>(i), static_cast<long long>(mCapacity));
+		}
+	}
+
+	void CheckWritable() const
+	{
+		if (!mFile.IsWritable())
+		{
+			throw mabz::UnexpectedMethodCall("Tried to modify a read-only MappedUnionFind.");
+		}
+	}
+
+	Index GetRoot(Index i) const
+	{
+		if (!mFile.IsWritable())
+		{
+			while (mEntries[i] >= 0) i = static_cast<Index>(mEntries[i]);
+			return i;
+		}
+		// path halving: point every other node at its grandparent on the way up.
+		while (mEntries[i] >= 0)
+		{
+			const Entry parent{mEntries[i]};
+			if (mEntries[parent] >= 0) mEntries[i] = mEntries[parent];
+			i = static_cast<Index>(mEntries[i]);
+		}
+		return i;
+	}
+
+	static void WriteHeader(MemoryMappedFile& file, std::uint64_t capacity)
+	{
+		UnionFindSnapshotHeader header;
+		std::memcpy(header.mMagic, kMagic, sizeof(kMagic));
+		header.mVersion = kVersion;
+		header.mEntryBytes = sizeof(Entry);
+		header.mCapacity = capacity;
+		std::memcpy(file.Data(), &header, sizeof(header));
+	}
+
+public:
+	static constexpr std::uint64_t MaxCapacity() { return static_cast<std::uint64_t>(std::numeric_limits<Entry>::max()); }
+
+	// Maps an existing snapshot. Read-only mappings are advised for random access.
+	static MappedUnionFind Open(const std::string& path, bool writable=false)
+	{
+		MemoryMappedFile file(path, writable);
+		if (!writable) file.AdviseRandomAccess();
+		return MappedUnionFind(std::move(file), path);
+	}
+
+	// Creates a snapshot file of capacity singleton sites, mapped writable.
+	static MappedUnionFind Create(const std::string& path, std::uint64_t capacity)
+	{
+		if (capacity > MaxCapacity())
+		{
+			std::stringstream err;
+			err << "MappedUnionFind capacity must be at most " << MaxCapacity()
+				<< " for this index type. Instead got " << capacity;
+			throw mabz::IllegalArgumentException(err.str());
+		}
+		MemoryMappedFile file = MemoryMappedFile::Create(path, FileSize(capacity));
+		WriteHeader(file, capacity);
+		MappedUnionFind uf(std::move(file), path);
+		uf.Reset();
+		return uf;
+	}
+
+	// Writes a snapshot of any union-find with Capacity(), Find() and
+	// ComponentSize() (UnionFind, CompactUnionFind, ...). Every site is written
+	// pointing straight at its root, so reading the snapshot back never walks
+	// more than one step.
+	template <typename UF>
+	static void Save(const UF& uf, const std::string& path)
+	{
+		MappedUnionFind snapshot = Create(path, static_cast<std::uint64_t>(uf.Capacity()));
+		for (Index i = 0; i < static_cast<Index>(uf.Capacity()); i++)
+		{
+			const auto root = uf.Find(i);
+			snapshot.mEntries[i] = static_cast<Index>(root) == i
+				? static_cast<Entry>(-static_cast<Entry>(uf.ComponentSize(i)))
+				: static_cast<Entry>(root);
+		}
+		snapshot.Flush();
+	}
+
+	MappedUnionFind(const MappedUnionFind&) = delete;
+	MappedUnionFind& operator = (const MappedUnionFind&) = delete;
+
+	// The mapping, and the entries pointing into it, move together; the
+	// moved-from MappedUnionFind is left with no sites.
+	MappedUnionFind(MappedUnionFind&& other)
+		: mFile(std::move(other.mFile))
+		, mEntries(other.mEntries)
+		, mCapacity(other.mCapacity)
+	{
+		other.mEntries = nullptr;
+		other.mCapacity = 0;
+	}
+
+	MappedUnionFind& operator = (MappedUnionFind&& other)
+	{
+		if (this != &other)
+		{
+			mFile = std::move(other.mFile);
+			mEntries = other.mEntries;
+			mCapacity = other.mCapacity;
+			other.mEntries = nullptr;
+			other.mCapacity = 0;
+		}
+		return *this;
+	}
+
+	Index Capacity() const { return mCapacity; }
+	bool IsWritable() const { return mFile.IsWritable(); }
+
+	// Makes every site a singleton again. Writable mappings only.
+	void Reset()
+	{
+		CheckWritable();
+		for (Index i = 0; i < mCapacity; i++)
+		{
+			mEntries[i] = -1;
+		}
+	}
+
+	Index Find(Index i) const
+	{
+		CheckArrayBounds(i);
+		return GetRoot(i);
+	}
+
+	Index ComponentSize(Index i) const
+	{
+		CheckArrayBounds(i);
+		return static_cast<Index>(-mEntries[GetRoot(i)]);
+	}
+
+	bool Connected(Index a, Index b) const
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		return GetRoot(a) == GetRoot(b);
+	}
+
+	// Writable mappings only.
+	void Union(Index a, Index b)
+	{
+		CheckWritable();
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		Index rootOfA{GetRoot(a)};
+		Index rootOfB{GetRoot(b)};
+
+		if (rootOfA == rootOfB) return;
+
+		// link the root of the smaller tree to the root of the larger tree.
+		// (sizes are stored negated, so "more negative" is bigger.)
+		if (mEntries[rootOfA] < mEntries[rootOfB])
+		{
+			const Index swapVal{rootOfA};
+			rootOfA = rootOfB;
+			rootOfB = swapVal;
+		}
+		mEntries[rootOfB] += mEntries[rootOfA];
+		mEntries[rootOfA] = static_cast<Entry>(rootOfB);
+	}
+
+	// Blocks until all Unions so far have reached the file.
+	void Flush() { mFile.Flush(); }
+};
+
+template <typename Index>
+constexpr char MappedUnionFind<Index>::kMagic[8];
+
+} /* namespace mabz */
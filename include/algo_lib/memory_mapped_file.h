@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mabz {
+
+// Owns a whole file mapped into memory (mmap on POSIX, a file mapping view on
+// Windows). Reads and writes through Data() go straight to the page cache, so
+// opening is O(1) regardless of file size and the OS decides what stays resident.
+// Throws mabz::FileError if anything goes wrong opening or mapping the file.
+class MemoryMappedFile
+{
+private:
+	void* mData{nullptr};
+	std::size_t mSize{0};
+	bool mWritable{false};
+	// OS handles: a file descriptor on POSIX (mMapping unused), HANDLEs on Windows.
+	std::intptr_t mFile{-1};
+	std::intptr_t mMapping{-1};
+
+	void Close();
+
+public:
+	// Maps an existing file, read-only unless writable is set. Writes through a
+	// writable mapping end up in the file.
+	MemoryMappedFile(const std::string& path, bool writable);
+
+	// Creates (or truncates) the file at path to exactly sizeInBytes and maps it
+	// read-write. The new contents are zero.
+	static MemoryMappedFile Create(const std::string& path, std::size_t sizeInBytes);
+
+	~MemoryMappedFile() { Close(); }
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator = (const MemoryMappedFile&) = delete;
+	MemoryMappedFile(MemoryMappedFile&&);
+	MemoryMappedFile& operator = (MemoryMappedFile&&);
+
+	void* Data() { return mData; }
+	const void* Data() const { return mData; }
+	std::size_t Size() const { return mSize; }
+	bool IsWritable() const { return mWritable; }
+
+	// Blocks until everything written so far has reached the file.
+	void Flush();
+
+	// Hints that the mapping will be accessed in random order, so the OS
+	// shouldn't bother reading ahead. A no-op where unsupported.
+	void AdviseRandomAccess();
+};
+
+} /* namespace mabz */
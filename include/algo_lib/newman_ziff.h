@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace mabz { namespace percolation {
+
+// Newman-Ziff site percolation on an n-by-n grid ("Fast Monte Carlo algorithm
+// for site or bond percolation", Phys. Rev. E 64, 2001).
+//
+// Each run opens every cell of the grid in one random order, and after every
+// single open records observables for that occupation number, so one O(n^2)
+// pass gives results for ALL occupation numbers 0..n^2 at once, instead of one
+// simulation per fixed p. The averages over runs are the "microcanonical"
+// observables; At(p) convolves them with the binomial distribution to give the
+// "canonical" value at any open probability p, a smooth curve in p.
+class NewmanZiff
+{
+public:
+	// Observables at one occupation number (or, from At, one probability p).
+	struct Observables
+	{
+		// fraction of runs in which an open cluster joined the top row to the bottom row.
+		double mSpanning{0};
+		// size of the largest open cluster as a fraction of all n^2 cells.
+		double mLargestClusterFraction{0};
+		// site-weighted mean size of the open clusters other than the largest,
+		// sum(s^2) / sum(s) over those clusters; 0 if there are none.
+		double mMeanClusterSize{0};
+	};
+
+private:
+	int mN;
+	int mRuns;
+	// indexed by occupation number, 0..n^2 inclusive.
+	std::vector<Observables> mByOccupation;
+
+	void RunOnce(std::vector<int>& order, std::uint64_t seed);
+
+public:
+	// Does all the runs up front. Runs are seeded seed, seed+1, ... so results
+	// are reproducible. Throws IllegalArgumentException unless n > 0 and runs > 0.
+	NewmanZiff(int n, int runs, std::uint64_t seed=0);
+
+	int N() const { return mN; }
+	int Runs() const { return mRuns; }
+	int Cells() const { return mN * mN; }
+
+	// Averages over runs with exactly "occupied" open cells (0..n^2).
+	const Observables& AtOccupation(int occupied) const;
+	const std::vector<Observables>& ByOccupation() const { return mByOccupation; }
+
+	// Expected observables when each cell is independently open with probability p.
+	Observables At(double p) const;
+
+	// Weights of the binomial distribution B(cells, p) for 0..cells, computed
+	// outwards from the mode and normalized so they sum to 1. Weights too small
+	// to matter are left as exactly 0.
+	static std::vector<double> BinomialWeights(int cells, double p);
+};
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace mabz {
+
+// Number of threads to actually use when a caller asks for "requested":
+// anything <= 0 means one per hardware thread.
+inline int ResolveThreadCount(int requested)
+{
+	if (requested > 0) return requested;
+	const unsigned hardware = std::thread::hardware_concurrency();
+	return hardware == 0 ? 1 : static_cast<int>(hardware);
+}
+
+// Splits [0, count) into threadCount contiguous ranges (fewer if count is small)
+// and calls func(threadIndex, begin, end) on each range from its own thread.
+// Blocks until all are done. If any of them throws, the first exception (by
+// thread index) is rethrown here once every thread has finished.
+template <typename Func>
+void ParallelFor(std::size_t count, int threadCount, Func func)
+{
+	threadCount = ResolveThreadCount(threadCount);
+	if (static_cast<std::size_t>(threadCount) > count) threadCount = count == 0 ? 1 : static_cast<int>(count);
+
+	if (threadCount == 1)
+	{
+		func(0, std::size_t{0}, count);
+		return;
+	}
+
+	std::vector<std::exception_ptr> errors(threadCount);
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (int t = 0; t < threadCount; t++)
+	{
+		const std::size_t begin = count * t / threadCount;
+		const std::size_t end = count * (t + 1) / threadCount;
+		threads.emplace_back([&func, &errors, t, begin, end]() {
+			try
+			{
+				func(t, begin, end);
+			}
+			catch (...)
+			{
+				errors[t] = std::current_exception();
+			}
+		});
+	}
+	for (auto& th : threads) th.join();
+
+	for (auto& err : errors)
+	{
+		if (err) std::rethrow_exception(err);
+	}
+}
+
+} /* namespace mabz */
@@ -1,26 +1,94 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <exception>
+#include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include <algo_lib/bit_grid.h>
+#include <algo_lib/cell_index.h>
+#include <algo_lib/compact_union_find.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/lazy_shuffle.h>
+#include <algo_lib/parallel.h>
+#include <algo_lib/rng.h>
+#include <algo_lib/running_stats.h>
 #include <algo_lib/union_find.h>
 
 namespace mabz { namespace percolation {
 
-class Percolation
+// Stands in for a uf_policy in BasicPercolation's UnionFindPolicy parameter to
+// back the grid with a CompactUnionFind<Index> instead of a UnionFind: one
+// Index-wide word per cell instead of two ints. std::uint32_t halves the
+// memory of the default up to n = 46340, and std::uint64_t takes n past that.
+template <typename Index>
+struct CompactStorage {};
+
+namespace detail {
+
+// The union-find class BasicPercolation uses for a given UnionFindPolicy,
+// its index type, and the most nodes it can hold.
+template <typename UnionFindPolicy>
+struct PercolationConnections
+{
+	using type = mabz::UnionFind<UnionFindPolicy>;
+	using node_type = int;
+	static constexpr long long kMaxNodes{INT_MAX};
+};
+
+template <typename Index>
+struct PercolationConnections<CompactStorage<Index> >
+{
+	using type = mabz::CompactUnionFind<Index>;
+	using node_type = Index;
+	static constexpr long long kMaxNodes{
+		mabz::CompactUnionFind<Index>::MaxCapacity() > static_cast<std::uint64_t>(LLONG_MAX)
+			? LLONG_MAX : static_cast<long long>(mabz::CompactUnionFind<Index>::MaxCapacity())};
+};
+
+} /* namespace detail */
+
+// UnionFindPolicy picks the union-find strategy backing the grid connectivity,
+// see mabz::uf_policy, or CompactStorage above. CellIndex picks how grid cells
+// are laid out in the union-find, see mabz::percolation::cell_index.
+template <typename UnionFindPolicy = mabz::DefaultUnionFindPolicy,
+	typename CellIndex = cell_index::RowMajor>
+class BasicPercolation
 {
 private:
-	mabz::UnionFind mConnections;
+	using Connections = detail::PercolationConnections<UnionFindPolicy>;
+	using Node = typename Connections::node_type;
 
-	// n x n grid, PLUS an "entry" node and an "exit" node, 
-    // where the 0th position in the vector is the entry node,
-    // grid position (row, col) is stored at vector position 
-    // 1 + n * (row-1) + (col-1) and position n^2 + 1 is the exit node.
-	// from 1 whereas obviously vector indexing starts from 0.
-	// true for open, false for closed.
 	int mN;
-	std::vector<bool> mGrid;
+	CellIndex mIndex;
+
+	// n x n grid, PLUS an "entry" node and an "exit" node, 
+    // where the 0th position in the union-find is the entry node,
+    // grid position (row, col) is stored at union-find position 
+    // 1 + mIndex.Index(row-1, col-1) and position mIndex.Size() + 1 is the exit node.
+	typename Connections::type mConnections;
+
+	// Open/closed state of each cell, one bit per cell: bit (row-1, col-1) is
+	// set for open. Keeps its own count of open cells.
+	mabz::BitGrid mGrid;
+
+	// Throws IllegalArgumentException unless n > 0, otherwise returns it.
+	static int CheckedSideLength(int n);
+
+	// Throws IllegalArgumentException unless the layout's cells plus the two
+	// virtual nodes fit in the union-find, otherwise returns that many nodes.
+	static Node CheckedNodeCount(const CellIndex& index, int n);
+
+	// union-find position of (row, col), both 1-based.
+	Node CellNode(int row, int col) const { return static_cast<Node>(1 + mIndex.Index(row-1, col-1)); }
+	Node ExitNode() const { return static_cast<Node>(mIndex.Size() + 1); }
 
 	// To be called after opening a previously closed cell in the grid.
 	// Expects row and col indices to already be checked/validated.
@@ -31,7 +99,7 @@ private:
 
 public:
     // creates n-by-n grid, with all sites initially blocked
-    Percolation(int n);
+    BasicPercolation(int n);
 
     // Lets you clear everything and start again if you want.
     void ResetGrid();
@@ -46,25 +114,323 @@ public:
     // to an open site in the top row.
     bool IsFull(int row, int col) const;
 
-    // returns the number of open sites
-    int GetNumberOfOpenSites() const;
+    // returns the number of open sites. O(1).
+    long long GetNumberOfOpenSites() const;
+
+    // whole-row queries, a word at a time rather than a cell at a time.
+    bool IsAnyOpenInRow(int row) const;
+    int GetNumberOfOpenSitesInRow(int row) const;
 
     // does the system percolate? 
     // true if there is a full site in the bottom row.
     bool DoesPercolate() const;
 };
 
-class PercolationStats 
+using Percolation = BasicPercolation<>;
+// For n past 46340, where n^2 cells no longer fit in an int: 8 bytes and a bit per cell.
+using LargePercolation = BasicPercolation<CompactStorage<std::uint64_t> >;
+
+template <typename UnionFindPolicy, typename CellIndex>
+void BasicPercolation<UnionFindPolicy, CellIndex>::CreateNewConnections(int row, int col)
+{
+	// we assume here that the cell at this row,col address is freshly opened.
+	const Node idx = CellNode(row, col);
+
+	// cell immediately to the left...
+	if (col > 1) 
+	{
+		if (mGrid.Get(row-1, col-2))
+		{
+			mConnections.Union(idx, CellNode(row, col-1));
+		}
+	}
+	// cell immediately to the right...
+	if (col < mN) 
+	{
+		if (mGrid.Get(row-1, col))
+		{
+			mConnections.Union(idx, CellNode(row, col+1));
+		}
+	}
+	// cell immediately above...
+	if (row > 1) 
+	{
+		if (mGrid.Get(row-2, col-1))
+		{
+			mConnections.Union(idx, CellNode(row-1, col));
+		}
+	}
+	else
+	{
+		// cell in the top row; connect to the entry node!
+		mConnections.Union(idx, 0);
+	}
+	// cell immediately below...
+	if (row < mN) 
+	{
+		if (mGrid.Get(row, col-1))
+		{
+			mConnections.Union(idx, CellNode(row+1, col));
+		}
+	}
+	else
+	{
+		// cell in the bottom row; connect to the exit node!
+		mConnections.Union(idx, ExitNode());
+	}
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+void BasicPercolation<UnionFindPolicy, CellIndex>::CheckRowColBounds(int row, int col) const
+{
+	if (row < 1 || row > mN)
+	{
+		std::stringstream err;
+		err << "Row index must be between 1 and " << mN << " inclusive. Got " << row;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	if (col < 1 || col > mN)
+	{
+		std::stringstream err;
+		err << "Col index must be between 1 and " << mN << " inclusive. Got " << col;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+int BasicPercolation<UnionFindPolicy, CellIndex>::CheckedSideLength(int n)
+{
+	if (n <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct Percolation class with n > 0. Instead got " << n;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	return n;
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+typename BasicPercolation<UnionFindPolicy, CellIndex>::Node
+BasicPercolation<UnionFindPolicy, CellIndex>::CheckedNodeCount(const CellIndex& index, int n)
+{
+	if (index.Size() > Connections::kMaxNodes - 2)
+	{
+		std::stringstream err;
+		err << "A " << n << " by " << n << " grid needs " << index.Size() << " cells in this layout, "
+		    << "but its union-find only holds " << Connections::kMaxNodes - 2
+		    << ". Use CompactStorage<std::uint64_t> (LargePercolation) for grids this big.";
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	return static_cast<Node>(index.Size() + 2);
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+BasicPercolation<UnionFindPolicy, CellIndex>::BasicPercolation(int n) 
+	: mN(CheckedSideLength(n))
+	, mIndex(n)
+	, mConnections(CheckedNodeCount(mIndex, n))
+	, mGrid(n, n)
+{
+	ResetGrid();
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+void BasicPercolation<UnionFindPolicy, CellIndex>::ResetGrid()
+{
+	// add the value/index number of every cell in the grid to our union,
+	// with nothing connected to anything else.
+	mConnections.Reset();
+	mGrid.ClearAll();
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+void BasicPercolation<UnionFindPolicy, CellIndex>::Open(int row, int col)
+{
+	CheckRowColBounds(row, col);
+	if (mGrid.Set(row-1, col-1))
+	{
+		CreateNewConnections(row, col);
+	}
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+bool BasicPercolation<UnionFindPolicy, CellIndex>::IsOpen(int row, int col) const 
+{ 
+	CheckRowColBounds(row, col);
+	return mGrid.Get(row-1, col-1); 
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+bool BasicPercolation<UnionFindPolicy, CellIndex>::IsFull(int row, int col) const
+{ 
+	CheckRowColBounds(row, col);
+	return mConnections.Connected(0, CellNode(row, col));
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+long long BasicPercolation<UnionFindPolicy, CellIndex>::GetNumberOfOpenSites() const
+{
+	return mGrid.Count();
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+bool BasicPercolation<UnionFindPolicy, CellIndex>::IsAnyOpenInRow(int row) const
+{
+	CheckRowColBounds(row, 1);
+	return mGrid.AnyInRow(row-1);
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+int BasicPercolation<UnionFindPolicy, CellIndex>::GetNumberOfOpenSitesInRow(int row) const
+{
+	CheckRowColBounds(row, 1);
+	return mGrid.CountInRow(row-1);
+}
+
+template <typename UnionFindPolicy, typename CellIndex>
+bool BasicPercolation<UnionFindPolicy, CellIndex>::DoesPercolate() const
+{
+	return mConnections.Connected(0, ExitNode());
+}
+
+namespace detail {
+
+// Everything one worker thread needs to run percolation trials, allocated once
+// up front: the grid with its union-find, and a lazy shuffle of the cells as
+// flat 0-based row * n + col indices. Each trial just resets them in place.
+// PercolationType is Percolation, or LargePercolation with a long long Cell
+// for grids whose n^2 + 2 nodes don't fit in an int.
+template <typename PercolationType, typename Cell>
+class PercolationTrialRunner
 {
 private:
+	int mN;
+	PercolationType mPercolation;
+	mabz::BasicLazyShuffle<Cell> mCells;
+	bool mFresh{true};
+
+public:
+	PercolationTrialRunner(int n)
+		: mN(n)
+		, mPercolation(n)
+		, mCells(static_cast<Cell>(n) * n)
+	{}
+
+	// Opens cells in a random order until the grid percolates, and returns the
+	// fraction that were opened. Only the cells actually opened get shuffled,
+	// and rewinding puts them back in order, so the result depends only on the
+	// engine, not on earlier trials.
+	template <typename Engine>
+	double Run(Engine& randEng)
+	{
+		if (!mFresh)
+		{
+			mPercolation.ResetGrid();
+			mCells.Rewind();
+		}
+		mFresh = false;
+
+		long long iterCount = 1;
+		while (mCells.Remaining() > 0)
+		{
+			// open that cell, see whether we've got a percolating grid or not...
+			const Cell cell{mCells.Next(randEng)};
+			mPercolation.Open(static_cast<int>(cell / mN) + 1, static_cast<int>(cell % mN) + 1);
+			if (mPercolation.DoesPercolate())
+			{
+				break;
+			}
+
+			iterCount++;
+		}
+		return static_cast<double>(iterCount) / static_cast<double>(mCells.Size());
+	}
+};
+
+using SmallPercolationTrialRunner = PercolationTrialRunner<Percolation, int>;
+using LargePercolationTrialRunner = PercolationTrialRunner<LargePercolation, long long>;
+
+// Whether an n-by-n grid is past what Percolation (int nodes) can hold.
+inline bool NeedsLargePercolation(int n)
+{
+	return static_cast<long long>(n) * n > PercolationConnections<mabz::DefaultUnionFindPolicy>::kMaxNodes - 2;
+}
+
+} /* namespace detail */
+
+// Engine is the random engine each trial draws from: one of the engines in
+// mabz::rng, or anything else with their seed constructor and Jump().
+template <typename Engine = mabz::rng::Xoshiro256StarStar>
+class BasicPercolationStats 
+{
+private:
+    long long mTrials;
     double mMean;
     double mStdev;
     double mConfidenceLow;
     double mConfidenceHigh;
 
+    // Trials are run in batches; each keeps one runner per thread across batches.
+    // Grids too big for Percolation run on LargePercolation runners instead.
+    class BatchRunner
+    {
+    private:
+        int mN;
+        int mThreadCount;
+        bool mLarge;
+        std::vector<std::unique_ptr<detail::SmallPercolationTrialRunner> > mRunners;
+        std::vector<std::unique_ptr<detail::LargePercolationTrialRunner> > mLargeRunners;
+        // positioned at the stream of the next trial to run.
+        Engine mNextStream;
+        std::vector<double> mThresholds;
+
+        template <typename Runner>
+        void RunOn(std::vector<std::unique_ptr<Runner> >& runners, int trials);
+
+    public:
+        BatchRunner(int n, int threadCount, std::uint64_t seed, std::uint64_t firstTrial);
+
+        int ThreadCount() const { return mThreadCount; }
+
+        // Runs the next "trials" trials across the threads and adds their
+        // thresholds to stats in trial order, so the sums don't depend on how
+        // the batch was split up.
+        void Run(int trials, mabz::RunningStats& stats);
+    };
+
+    static void CheckSideLength(int n);
+
+    // the results of the trials summarised in stats.
+    BasicPercolationStats(const mabz::RunningStats& stats);
+
 public:
-    // perform independent trials on an n-by-n grid
-    PercolationStats(int n, int trials);
+    // perform independent trials on an n-by-n grid, spread over threadCount
+    // threads (<= 0 means one per hardware thread). Trial i draws from stream
+    // i of the seed, Engine(seed) jumped i times, so the results are the same
+    // for any thread count. Separate processes can share out one seed's trials
+    // without overlap by each starting at a different firstTrial.
+    // Past n = 46340 the trials run on LargePercolation with 64-bit cell ids,
+    // which takes about 16 bytes per cell per thread.
+    BasicPercolationStats(int n, int trials, int threadCount = 0, std::uint64_t seed = 0,
+        std::uint64_t firstTrial = 0);
+
+    // Runs trials until the 95% confidence half-width is at most halfWidth,
+    // rather than a fixed number of them. Batches of at least kMinBatch trials
+    // run in parallel, each sized from the spread so far to just reach the
+    // target (but at most doubling the count), so it overshoots by little.
+    // Stops early once timeBudget has run out; that is only checked between
+    // batches, but a batch is cut down to what the time left looks like it can
+    // fit. Batch sizes depend only on the results, so without a time limit the
+    // outcome is again the same for any thread count. Trials draw from streams
+    // firstTrial, firstTrial + 1, ... of the seed, as for the constructor.
+    static BasicPercolationStats UntilHalfWidth(int n, double halfWidth,
+        std::chrono::milliseconds timeBudget = std::chrono::milliseconds::max(),
+        int threadCount = 0, std::uint64_t seed = 0, std::uint64_t firstTrial = 0);
+
+    static constexpr int kMinBatch{64};
+
+    // number of trials run
+    long long Trials() const { return mTrials; }
 
     // sample mean of percolation threshold
     double Mean() const { return mMean; }
@@ -79,5 +445,142 @@ public:
     double ConfidenceHigh() const { return mConfidenceHigh; }
 };
 
+using PercolationStats = BasicPercolationStats<>;
+
+template <typename Engine>
+BasicPercolationStats<Engine>::BatchRunner::BatchRunner(int n, int threadCount, std::uint64_t seed,
+	std::uint64_t firstTrial)
+	: mN(n)
+	, mThreadCount(mabz::ResolveThreadCount(threadCount))
+	, mLarge(detail::NeedsLargePercolation(n))
+	, mRunners(mLarge ? 0 : mThreadCount)
+	, mLargeRunners(mLarge ? mThreadCount : 0)
+	, mNextStream(seed)
+{
+	mNextStream.Jump(firstTrial);
+}
+
+template <typename Engine>
+template <typename Runner>
+void BasicPercolationStats<Engine>::BatchRunner::RunOn(std::vector<std::unique_ptr<Runner> >& runners, int trials)
+{
+	mabz::ParallelFor(trials, mThreadCount, [&](int t, std::size_t begin, std::size_t end) {
+		// made on first use, by the thread that will use it.
+		if (!runners[t]) runners[t].reset(new Runner(mN));
+		Engine streamStart(mNextStream);
+		streamStart.Jump(begin);
+		for (std::size_t i = begin; i < end; i++)
+		{
+			Engine randEng(streamStart);
+			mThresholds[i] = runners[t]->Run(randEng);
+			streamStart.Jump();
+		}
+	});
+}
+
+template <typename Engine>
+void BasicPercolationStats<Engine>::BatchRunner::Run(int trials, mabz::RunningStats& stats)
+{
+	mThresholds.resize(trials);
+	if (mLarge)
+	{
+		RunOn(mLargeRunners, trials);
+	}
+	else
+	{
+		RunOn(mRunners, trials);
+	}
+	mNextStream.Jump(trials);
+
+	for (double t : mThresholds) stats.Add(t);
+}
+
+template <typename Engine>
+void BasicPercolationStats<Engine>::CheckSideLength(int n)
+{
+	if (n <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct PercolationStats with positive n. Instead, got n: " << n;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+template <typename Engine>
+BasicPercolationStats<Engine>::BasicPercolationStats(const mabz::RunningStats& stats)
+	: mTrials(stats.Count())
+	, mMean(stats.Mean())
+	, mStdev(stats.Stdev())
+{
+	const double confidenceHalfWidth = stats.HalfWidth95();
+	mConfidenceLow = mMean - confidenceHalfWidth;
+	mConfidenceHigh = mMean + confidenceHalfWidth;
+}
+
+template <typename Engine>
+BasicPercolationStats<Engine>::BasicPercolationStats(int n, int trials, int threadCount, std::uint64_t seed,
+	std::uint64_t firstTrial)
+{
+	CheckSideLength(n);
+	if (trials <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct PercolationStats with positive trials. Instead, got trials: " << trials;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	BatchRunner runner(n, threadCount, seed, firstTrial);
+	std::cout << "Running percolation stats with n: " << n << " and trials: " << trials
+	          << " on " << runner.ThreadCount() << " threads" << std::endl;
+
+	mabz::RunningStats stats;
+	runner.Run(trials, stats);
+	*this = BasicPercolationStats(stats);
+}
+
+template <typename Engine>
+BasicPercolationStats<Engine> BasicPercolationStats<Engine>::UntilHalfWidth(int n, double halfWidth,
+	std::chrono::milliseconds timeBudget, int threadCount, std::uint64_t seed, std::uint64_t firstTrial)
+{
+	CheckSideLength(n);
+	if (!(halfWidth > 0) || timeBudget.count() < 0)
+	{
+		std::stringstream err;
+		err << "Must run PercolationStats to a positive half-width within a non-negative time budget. "
+		    << "Instead, got half-width: " << halfWidth << " and budget: " << timeBudget.count() << "ms";
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	BatchRunner runner(n, threadCount, seed, firstTrial);
+	std::cout << "Running percolation stats with n: " << n << " to a 95% half-width of " << halfWidth
+	          << " on " << runner.ThreadCount() << " threads" << std::endl;
+
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start{Clock::now()};
+	mabz::RunningStats stats;
+	int batch{kMinBatch};
+	while (true)
+	{
+		runner.Run(batch, stats);
+		if (!(stats.HalfWidth95() > halfWidth)) break;
+
+		const double elapsedMs{std::chrono::duration<double, std::milli>(Clock::now() - start).count()};
+		const double leftMs{static_cast<double>(timeBudget.count()) - elapsedMs};
+		if (leftMs <= 0) break;
+
+		// n needs to reach (1.96 s / halfWidth)^2; aim there, but no more than
+		// doubling so a poor early estimate of s can't send it too far.
+		const double count{static_cast<double>(stats.Count())};
+		const double ratio{1.96 * stats.Stdev() / halfWidth};
+		double next{std::min(std::max(std::ceil(ratio * ratio) - count, static_cast<double>(kMinBatch)), count)};
+
+		// and no more than the time left looks like it can fit.
+		next = std::min(next, std::floor(leftMs * count / elapsedMs));
+		if (next < 1) break;
+		batch = static_cast<int>(std::min(next, static_cast<double>(INT_MAX)));
+	}
+	return BasicPercolationStats(stats);
+}
+
 } /* namespace percolation */
-} /* namespace mabz */
\ No newline at end of file
+} /* namespace mabz */
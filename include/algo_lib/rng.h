@@ -0,0 +1,433 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace mabz { namespace rng {
+
+// Fast 64-bit random engines for Monte Carlo trials, as drop-in alternatives to
+// the standard engines. Each one is a UniformRandomBitGenerator producing 64
+// uniform bits per call (so it works with <random> and std::shuffle), and each
+// can be split into non-overlapping streams for parallel workers or separate
+// processes. They all have
+//   Engine(std::uint64_t seed);      // any seed, including 0, is fine
+//   void Jump(std::uint64_t times);  // move on by "times" streams
+//   void Discard(std::uint64_t n);   // skip the next n outputs
+// Stream k of a seed is Engine(seed) then Jump(k). Every stream is at least
+// 2^64 outputs long, so streams never overlap in practice. Jump and Discard
+// cost O(log times) / O(log n) for all three engines (O(1) for Philox), so
+// starting a shard a billion streams in is as cheap as starting at stream 1.
+
+// The high and low halves of a 128-bit product, and 128-bit arithmetic mod 2^128
+// built on it, for the engines with 128-bit state.
+struct UInt128
+{
+	std::uint64_t mHi;
+	std::uint64_t mLo;
+};
+
+inline UInt128 MultiplyFull(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	const unsigned __int128 product{static_cast<unsigned __int128>(a) * b};
+	return UInt128{static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+	UInt128 result;
+	result.mLo = _umul128(a, b, &result.mHi);
+	return result;
+#else
+	const std::uint64_t aLo{a & 0xFFFFFFFFull}, aHi{a >> 32};
+	const std::uint64_t bLo{b & 0xFFFFFFFFull}, bHi{b >> 32};
+	const std::uint64_t loLo{aLo * bLo};
+	const std::uint64_t hiLo{aHi * bLo};
+	const std::uint64_t loHi{aLo * bHi};
+	const std::uint64_t cross{(loLo >> 32) + (hiLo & 0xFFFFFFFFull) + loHi};
+	return UInt128{aHi * bHi + (hiLo >> 32) + (cross >> 32), (cross << 32) | (loLo & 0xFFFFFFFFull)};
+#endif
+}
+
+inline UInt128 operator*(UInt128 a, UInt128 b)
+{
+	UInt128 result{MultiplyFull(a.mLo, b.mLo)};
+	result.mHi += a.mHi * b.mLo + a.mLo * b.mHi;
+	return result;
+}
+
+inline UInt128 operator+(UInt128 a, UInt128 b)
+{
+	const std::uint64_t lo{a.mLo + b.mLo};
+	return UInt128{a.mHi + b.mHi + (lo < a.mLo ? 1 : 0), lo};
+}
+
+inline bool operator==(UInt128 a, UInt128 b) { return a.mHi == b.mHi && a.mLo == b.mLo; }
+
+inline std::uint64_t RotateLeft(std::uint64_t x, int k) { return (x << k) | (x >> ((64 - k) & 63)); }
+inline std::uint64_t RotateRight(std::uint64_t x, int k) { return (x >> k) | (x << ((64 - k) & 63)); }
+
+// SplitMix64, used to spread a 64-bit seed over a bigger state. Advances x.
+inline std::uint64_t SplitMix64(std::uint64_t& x)
+{
+	std::uint64_t z{x += 0x9E3779B97F4A7C15ull};
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+// Blackman and Vigna's xoshiro256**: 256 bits of state, a handful of shifts,
+// rotates and xors per output. Period 2^256 - 1. Jump() is their 2^128 jump
+// polynomial, so there are 2^128 streams of 2^128 outputs each.
+//
+// The state update is linear over GF(2), so moving k steps on is applying
+// x^k mod P, P the update's characteristic polynomial, to the state. Jump and
+// Discard raise their polynomial to the power they need by repeated squaring
+// mod P, then apply it with one pass of 256 steps: O(log k) multiplies of
+// 256-bit polynomials rather than k jumps or k steps.
+class Xoshiro256StarStar
+{
+private:
+	// A polynomial over GF(2) of degree < 256: bit i of word i / 64 is the
+	// coefficient of x^i.
+	using Polynomial = std::uint64_t[4];
+
+	// The characteristic polynomial of the state update, less its x^256 term.
+	// x^(2^128) mod it is the reference jump polynomial kJump below.
+	static constexpr std::uint64_t kCharPoly[4] = {
+		0x9D116F2BB0F0F001ull, 0x0280002BCEFD1A5Eull, 0x04B4EDCF26259F85ull, 0x0003C03C3F3ECB19ull};
+	static constexpr std::uint64_t kJump[4] = {
+		0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+
+	std::uint64_t mState[4];
+
+	// out = a * b mod kCharPoly. out may alias a or b.
+	static void MultiplyMod(const Polynomial& a, const Polynomial& b, Polynomial& out)
+	{
+		std::uint64_t shifted[4] = {a[0], a[1], a[2], a[3]};
+		std::uint64_t product[4] = {0, 0, 0, 0};
+		for (int bit = 0; bit < 256; bit++)
+		{
+			if (b[bit >> 6] & (std::uint64_t{1} << (bit & 63)))
+			{
+				for (int i = 0; i < 4; i++) product[i] ^= shifted[i];
+			}
+			// shifted *= x, reducing the x^256 term that falls off the top.
+			const bool carry{(shifted[3] >> 63) != 0};
+			shifted[3] = (shifted[3] << 1) | (shifted[2] >> 63);
+			shifted[2] = (shifted[2] << 1) | (shifted[1] >> 63);
+			shifted[1] = (shifted[1] << 1) | (shifted[0] >> 63);
+			shifted[0] <<= 1;
+			if (carry)
+			{
+				for (int i = 0; i < 4; i++) shifted[i] ^= kCharPoly[i];
+			}
+		}
+		for (int i = 0; i < 4; i++) out[i] = product[i];
+	}
+
+	// out = base^exponent mod kCharPoly, for exponent >= 1.
+	static void PowerMod(const Polynomial& base, std::uint64_t exponent, Polynomial& out)
+	{
+		std::uint64_t square[4] = {base[0], base[1], base[2], base[3]};
+		bool started{false};
+		for (; exponent > 0; exponent >>= 1)
+		{
+			if (exponent & 1)
+			{
+				if (started)
+				{
+					MultiplyMod(out, square, out);
+				}
+				else
+				{
+					for (int i = 0; i < 4; i++) out[i] = square[i];
+					started = true;
+				}
+			}
+			if (exponent > 1) MultiplyMod(square, square, square);
+		}
+	}
+
+	// Moves the state on by the number of steps poly stands for.
+	void Apply(const Polynomial& poly)
+	{
+		std::uint64_t moved[4] = {0, 0, 0, 0};
+		for (std::uint64_t word : poly)
+		{
+			for (int bit = 0; bit < 64; bit++)
+			{
+				if (word & (std::uint64_t{1} << bit))
+				{
+					for (int i = 0; i < 4; i++) moved[i] ^= mState[i];
+				}
+				(*this)();
+			}
+		}
+		for (int i = 0; i < 4; i++) mState[i] = moved[i];
+	}
+
+public:
+	using result_type = std::uint64_t;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	Xoshiro256StarStar(std::uint64_t seed)
+	{
+		for (auto& word : mState) word = SplitMix64(seed);
+	}
+
+	// Exactly this state, which must not be all zero. For reproducing reference outputs.
+	Xoshiro256StarStar(std::uint64_t s0, std::uint64_t s1, std::uint64_t s2, std::uint64_t s3)
+		: mState{s0, s1, s2, s3}
+	{}
+
+	result_type operator()()
+	{
+		const std::uint64_t result{RotateLeft(mState[1] * 5, 7) * 9};
+		const std::uint64_t t{mState[1] << 17};
+		mState[2] ^= mState[0];
+		mState[3] ^= mState[1];
+		mState[1] ^= mState[2];
+		mState[0] ^= mState[3];
+		mState[2] ^= t;
+		mState[3] = RotateLeft(mState[3], 45);
+		return result;
+	}
+
+	// O(log times): 256 steps plus up to 2 log2(times) polynomial multiplies.
+	void Jump(std::uint64_t times = 1)
+	{
+		if (times == 0) return;
+		std::uint64_t poly[4];
+		PowerMod(kJump, times, poly);
+		Apply(poly);
+	}
+
+	// O(log n) as for Jump, except that short skips just step.
+	void Discard(std::uint64_t n)
+	{
+		if (n < 256)
+		{
+			for (; n > 0; n--) (*this)();
+			return;
+		}
+		const std::uint64_t x[4] = {2, 0, 0, 0};
+		std::uint64_t poly[4];
+		PowerMod(x, n, poly);
+		Apply(poly);
+	}
+
+	bool operator==(const Xoshiro256StarStar& other) const
+	{
+		return mState[0] == other.mState[0] && mState[1] == other.mState[1]
+			&& mState[2] == other.mState[2] && mState[3] == other.mState[3];
+	}
+};
+
+// O'Neill's PCG64 (XSL RR 128/64): a 128-bit LCG with a xorshift-rotate output
+// permutation. Same outputs as pcg64 from the reference pcg-cpp for the same
+// seed and stream. The LCG can be advanced any distance in O(log distance)
+// multiplies, so Discard is cheap and Jump() moves 2^64 outputs on.
+class Pcg64
+{
+private:
+	static constexpr UInt128 kMultiplier{0x2360ED051FC65DA4ull, 0x4385DF649FCCF645ull};
+
+	UInt128 mState;
+	UInt128 mIncrement;
+
+	void Step() { mState = mState * kMultiplier + mIncrement; }
+
+	// Brown's "random number generation with arbitrary strides": composes the
+	// affine step with itself by repeated squaring.
+	void Advance(UInt128 delta)
+	{
+		UInt128 accMultiplier{0, 1};
+		UInt128 accIncrement{0, 0};
+		UInt128 curMultiplier{kMultiplier};
+		UInt128 curIncrement{mIncrement};
+		while (delta.mHi != 0 || delta.mLo != 0)
+		{
+			if (delta.mLo & 1)
+			{
+				accMultiplier = accMultiplier * curMultiplier;
+				accIncrement = accIncrement * curMultiplier + curIncrement;
+			}
+			curIncrement = (curMultiplier + UInt128{0, 1}) * curIncrement;
+			curMultiplier = curMultiplier * curMultiplier;
+			delta.mLo = (delta.mLo >> 1) | (delta.mHi << 63);
+			delta.mHi >>= 1;
+		}
+		mState = accMultiplier * mState + accIncrement;
+	}
+
+public:
+	using result_type = std::uint64_t;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	// Different streams are different LCG increments, so they are separate
+	// sequences rather than far apart points on one.
+	Pcg64(std::uint64_t seed, std::uint64_t stream = 0)
+		: mState{0, 0}
+		, mIncrement{stream >> 63, (stream << 1) | 1}
+	{
+		mState = UInt128{0, seed} + mIncrement;
+		Step();
+	}
+
+	result_type operator()()
+	{
+		Step();
+		const std::uint64_t folded{mState.mHi ^ mState.mLo};
+		return RotateRight(folded, static_cast<int>(mState.mHi >> 58));
+	}
+
+	// O(log times).
+	void Jump(std::uint64_t times = 1) { Advance(UInt128{times, 0}); }
+
+	// O(log n).
+	void Discard(std::uint64_t n) { Advance(UInt128{0, n}); }
+
+	bool operator==(const Pcg64& other) const
+	{
+		return mState == other.mState && mIncrement == other.mIncrement;
+	}
+};
+
+// Salmon et al.'s Philox4x32-10, the counter-based engine from Random123: each
+// 128-bit counter value is pushed through ten rounds of multiply-xor keyed by the
+// seed, giving four 32-bit words, handed out as two 64-bit outputs. There is no
+// state to step, so Jump and Discard are O(1). The upper 64 counter bits are the
+// stream and the lower 64 count blocks within it. Same words as Random123's
+// philox4x32 with key {seed low, seed high}.
+class Philox4x32
+{
+public:
+	using Block = std::uint32_t[4];
+
+private:
+	std::uint32_t mKey[2];
+	std::uint64_t mBlock{0};
+	std::uint64_t mStream{0};
+	std::uint64_t mOutput[2];
+	// 0 or 1: the next of mOutput to hand out; 2: mBlock needs generating.
+	int mNextOutput{2};
+
+	void Generate()
+	{
+		Block words;
+		Encrypt(mKey, mBlock, mStream, words);
+		mOutput[0] = (static_cast<std::uint64_t>(words[1]) << 32) | words[0];
+		mOutput[1] = (static_cast<std::uint64_t>(words[3]) << 32) | words[2];
+		mBlock++;
+		if (mBlock == 0) mStream++;
+		mNextOutput = 0;
+	}
+
+public:
+	using result_type = std::uint64_t;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	Philox4x32(std::uint64_t seed)
+		: mKey{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}
+	{}
+
+	// The raw block function: ten rounds over counter {blockLo, blockHi,
+	// streamLo, streamHi} with the given key.
+	static void Encrypt(const std::uint32_t key[2], std::uint64_t block, std::uint64_t stream, Block out)
+	{
+		std::uint32_t c0{static_cast<std::uint32_t>(block)}, c1{static_cast<std::uint32_t>(block >> 32)};
+		std::uint32_t c2{static_cast<std::uint32_t>(stream)}, c3{static_cast<std::uint32_t>(stream >> 32)};
+		std::uint32_t k0{key[0]}, k1{key[1]};
+		for (int round = 0; round < 10; round++)
+		{
+			const std::uint64_t p0{static_cast<std::uint64_t>(0xD2511F53u) * c0};
+			const std::uint64_t p1{static_cast<std::uint64_t>(0xCD9E8D57u) * c2};
+			c0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+			c1 = static_cast<std::uint32_t>(p1);
+			c2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+			c3 = static_cast<std::uint32_t>(p0);
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+		out[0] = c0;
+		out[1] = c1;
+		out[2] = c2;
+		out[3] = c3;
+	}
+
+	result_type operator()()
+	{
+		if (mNextOutput == 2) Generate();
+		return mOutput[mNextOutput++];
+	}
+
+	void Jump(std::uint64_t times = 1)
+	{
+		mStream += times;
+		mBlock = 0;
+		mNextOutput = 2;
+	}
+
+	void Discard(std::uint64_t n)
+	{
+		// use up the current block first, then skip whole blocks of two.
+		while (n > 0 && mNextOutput < 2)
+		{
+			mNextOutput++;
+			n--;
+		}
+		const std::uint64_t blocks{n / 2};
+		mBlock += blocks;
+		if (mBlock < blocks) mStream++;
+		if (n % 2 == 1)
+		{
+			Generate();
+			mNextOutput = 1;
+		}
+	}
+};
+
+// Uniform in [0, range), range > 0, from a source of 32 uniform bits per call:
+// Lemire's multiply-shift with rejection, so it is exactly unbiased and only
+// divides on the rare rejection path (std::uniform_int_distribution typically
+// divides on every call).
+template <typename Bits32>
+std::uint32_t Bounded32(Bits32&& nextBits, std::uint32_t range)
+{
+	std::uint64_t product{static_cast<std::uint64_t>(nextBits()) * range};
+	if (static_cast<std::uint32_t>(product) < range)
+	{
+		const std::uint32_t threshold{(0u - range) % range};
+		while (static_cast<std::uint32_t>(product) < threshold)
+		{
+			product = static_cast<std::uint64_t>(nextBits()) * range;
+		}
+	}
+	return static_cast<std::uint32_t>(product >> 32);
+}
+
+// As Bounded32, for the full 64-bit range, from an engine producing 64 bits.
+template <typename Engine>
+std::uint64_t Bounded(Engine& randEng, std::uint64_t range)
+{
+	static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<std::uint64_t>::max(),
+		"Bounded needs an engine that produces 64 uniform bits.");
+	UInt128 product{MultiplyFull(randEng(), range)};
+	if (product.mLo < range)
+	{
+		const std::uint64_t threshold{(0 - range) % range};
+		while (product.mLo < threshold)
+		{
+			product = MultiplyFull(randEng(), range);
+		}
+	}
+	return product.mHi;
+}
+
+} /* namespace rng */
+} /* namespace mabz */
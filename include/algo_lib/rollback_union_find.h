@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace mabz {
+
+// Union-find whose unions can be undone, most recent first.
+// Uses union by size and deliberately NO path compression: every Union changes
+// exactly one parent pointer and one size, so it can be logged and reversed in
+// O(1), and trees stay O(log n) deep without compression.
+//
+// Checkpoint() returns a marker for the current state; RollbackTo(marker) undoes
+// every Union made since, in O(number of unions undone). Markers nest like a
+// stack: rolling back to an older one invalidates any taken after it.
+class RollbackUnionFind
+{
+private:
+	int mCapacity;
+	int* mRoots{nullptr};
+	int* mTreeSizes{nullptr};
+	int mComponentCount;
+	// The root that was linked under another root by each effective Union,
+	// oldest first. Its parent and the size to subtract are read back off the arrays.
+	std::vector<int> mUndoLog;
+
+	void CheckArrayBounds(int i) const
+	{
+		if (i < 0 || i >= mCapacity) ThrowIndexOutOfRange(i, mCapacity);
+	}
+
+	int GetRoot(int i) const
+	{
+		while (i != mRoots[i]) i = mRoots[i];
+		return i;
+	}
+
+public:
+	RollbackUnionFind(int capacity)
+		: mCapacity(capacity)
+		, mRoots(new int[capacity]())
+		, mTreeSizes(new int[capacity]())
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		for (int i = 0; i < mCapacity; i++)
+		{
+			mRoots[i] = i;
+			mTreeSizes[i] = 1;
+		}
+		mComponentCount = mCapacity;
+		mUndoLog.clear();
+	}
+	~RollbackUnionFind()
+	{
+		delete[] mRoots;
+		delete[] mTreeSizes;
+	}
+
+	RollbackUnionFind() = delete;
+	RollbackUnionFind(const RollbackUnionFind&) = delete;
+	RollbackUnionFind(RollbackUnionFind&&) = delete;
+
+	int Capacity() const { return mCapacity; }
+	int ComponentCount() const { return mComponentCount; }
+
+	int Find(int i) const
+	{
+		CheckArrayBounds(i);
+		return GetRoot(i);
+	}
+
+	// Returns true if a and b were in different components (i.e. something was
+	// linked and logged).
+	bool Union(int a, int b)
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		int rootOfA{GetRoot(a)};
+		int rootOfB{GetRoot(b)};
+
+		if (rootOfA == rootOfB) return false;
+
+		// link the root of the smaller tree to the root of the larger tree
+		if (mTreeSizes[rootOfA] > mTreeSizes[rootOfB])
+		{
+			const int swapVal{rootOfA};
+			rootOfA = rootOfB;
+			rootOfB = swapVal;
+		}
+		mRoots[rootOfA] = rootOfB;
+		mTreeSizes[rootOfB] += mTreeSizes[rootOfA];
+		mComponentCount--;
+		mUndoLog.push_back(rootOfA);
+		return true;
+	}
+
+	bool Connected(int a, int b) const
+	{
+		CheckArrayBounds(a);
+		CheckArrayBounds(b);
+
+		return GetRoot(a) == GetRoot(b);
+	}
+
+	std::size_t Checkpoint() const { return mUndoLog.size(); }
+
+	void RollbackTo(std::size_t checkpoint)
+	{
+		if (checkpoint > mUndoLog.size())
+		{
+			std::stringstream err;
+			err << "Cannot roll back to checkpoint " << checkpoint
+				<< "; only " << mUndoLog.size() << " unions are on the undo log.";
+			throw mabz::IllegalArgumentException(err.str());
+		}
+
+		while (mUndoLog.size() > checkpoint)
+		{
+			const int child{mUndoLog.back()};
+			mUndoLog.pop_back();
+			const int parent{mRoots[child]};
+			mTreeSizes[parent] -= mTreeSizes[child];
+			mRoots[child] = child;
+			mComponentCount++;
+		}
+	}
+
+	// Undo just the most recent effective Union.
+	void Undo()
+	{
+		if (mUndoLog.empty())
+		{
+			throw mabz::EmptyContainer("Tried to Undo with nothing on the undo log.");
+		}
+		RollbackTo(mUndoLog.size() - 1);
+	}
+};
+
+} /* namespace mabz */
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+namespace mabz {
+
+// Mean and variance of a stream of samples in one pass and O(1) memory, by
+// Welford's method: numerically stable where the textbook sum of squares
+// cancels badly once the mean is large next to the spread.
+class RunningStats
+{
+private:
+	long long mCount{0};
+	double mMean{0};
+	// sum of squared differences from the current mean.
+	double mSumSqDiffs{0};
+
+public:
+	void Add(double x)
+	{
+		mCount++;
+		const double delta{x - mMean};
+		mMean += delta / mCount;
+		mSumSqDiffs += delta * (x - mMean);
+	}
+
+	long long Count() const { return mCount; }
+
+	// NaN until there is a sample.
+	double Mean() const { return mCount > 0 ? mMean : std::numeric_limits<double>::quiet_NaN(); }
+
+	// sample variance (n - 1 in the denominator); NaN until there are two samples.
+	double Variance() const
+	{
+		return mCount > 1 ? mSumSqDiffs / (mCount - 1) : std::numeric_limits<double>::quiet_NaN();
+	}
+
+	double Stdev() const { return std::sqrt(Variance()); }
+
+	// half-width of the normal-approximation 95% confidence interval for the mean.
+	double HalfWidth95() const { return 1.96 * Stdev() / std::sqrt(static_cast<double>(mCount)); }
+};
+
+} /* namespace mabz */
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <algo_lib/union_find.h>
+
+namespace mabz { namespace percolation {
+
+// Hoshen-Kopelman style percolation analysis of a fixed grid that is fed in one
+// row at a time, for grids far too big to hold in memory. Only the labels of
+// the previous row and a union-find over 2 * width labels are kept, so memory is
+// O(width) no matter how many rows there are.
+//
+// After each row the labels still present in it are renumbered 0..k-1, carrying
+// their cluster's size and whether it touches the top row; any cluster that no
+// longer reaches the current row is complete and goes into the statistics.
+// The grid percolates if a cluster touching the top row is still alive after
+// the last row (i.e. reaches the bottom).
+class StreamingPercolation
+{
+private:
+	int mWidth;
+	long long mRows{0};
+	bool mFinished{false};
+
+	// Labels 0..mCarried-1 are the clusters alive in the previous row;
+	// label mCarried + c is the fresh label of cell c in the row being added.
+	mabz::UnionFind<> mLabels;
+	int mCarried{0};
+	// per label, only meaningful at union-find roots.
+	std::vector<long long> mClusterSizes;
+	std::vector<unsigned char> mTouchesTop;
+	// compact label of each cell of the previous row, -1 if closed.
+	std::vector<int> mPreviousRow;
+	// scratch for renumbering, -1 for "not yet numbered".
+	std::vector<int> mRenumber;
+	std::vector<long long> mSizeScratch;
+	std::vector<unsigned char> mTopScratch;
+	std::vector<unsigned char> mRowScratch;
+
+	long long mOpenSites{0};
+	long long mClusterCount{0};
+	long long mLargestClusterSize{0};
+	bool mPercolates{false};
+
+	void CheckNotFinished() const;
+	void CheckFinished() const;
+	void FinishCluster(long long size);
+
+public:
+	// width is the number of cells in every row.
+	StreamingPercolation(int width);
+
+	int Width() const { return mWidth; }
+	long long Rows() const { return mRows; }
+
+	// Adds the next row down: width cells, non-zero for open.
+	void AddRow(const unsigned char* cells);
+
+	// Same, packed 8 cells per byte, least significant bit first.
+	void AddPackedRow(const unsigned char* bits);
+
+	// Call after the last row; the statistics below are available from then on.
+	void Finish();
+
+	bool DoesPercolate() const;
+	long long GetNumberOfOpenSites() const;
+	long long GetNumberOfClusters() const;
+	long long GetLargestClusterSize() const;
+
+	// Feeds rows produced by generator(rowIndex, cellsOut) until rows rows, then
+	// finishes. cellsOut has room for width cells, non-zero for open.
+	static StreamingPercolation Analyze(int width, long long rows,
+		const std::function<void(long long, unsigned char*)>& generator);
+
+	// Reads a file of back-to-back packed rows, each ceil(width / 8) bytes
+	// laid out as for AddPackedRow, and finishes. The row count is the file size
+	// divided by the row size. Throws mabz::FileError on IO errors or a
+	// partial last row.
+	static StreamingPercolation AnalyzeFile(int width, const std::string& path);
+};
+
+} /* namespace percolation */
+} /* namespace mabz */
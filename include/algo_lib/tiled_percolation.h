@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include <algo_lib/bit_grid.h>
+
+namespace mabz { namespace percolation {
+
+// Cluster labelling of a whole static grid at once, split across threads.
+//
+// The grid is cut into horizontal strips of rows, one per thread. Each thread
+// labels the open clusters of its own strip with a local union-find. A serial
+// stitching pass then joins strip clusters that touch across the strip
+// boundaries (only cols cells per boundary), and a second parallel pass rewrites
+// every cell's label to its final cluster number. After construction every
+// query is O(1).
+//
+// Rows and cols are 1-based, matching Percolation; a cell is connected to its
+// left/right/up/down neighbours. The grid percolates if one cluster touches
+// both the top and bottom rows.
+class TiledPercolation
+{
+private:
+	int mRows;
+	int mCols;
+	// cluster number of each cell, row-major; -1 for closed cells.
+	std::vector<int> mLabels;
+	std::vector<long long> mClusterSizes;
+	std::vector<unsigned char> mTouchesTop;
+	long long mOpenSites{0};
+	long long mLargestClusterSize{0};
+	bool mPercolates{false};
+
+	// Throw IllegalArgumentException if out of bounds.
+	void CheckRowColBounds(int row, int col) const;
+	int LabelAt(int row, int col) const;
+
+public:
+	// Labels every open (set) cell of grid using threadCount threads, one per
+	// hardware thread if threadCount <= 0. Throws IllegalArgumentException for
+	// an empty grid.
+	TiledPercolation(const mabz::BitGrid& grid, int threadCount=0);
+
+	int Rows() const { return mRows; }
+	int Cols() const { return mCols; }
+
+	bool IsOpen(int row, int col) const;
+	// connected to an open site in the top row?
+	bool IsFull(int row, int col) const;
+	bool DoesPercolate() const { return mPercolates; }
+
+	long long GetNumberOfOpenSites() const { return mOpenSites; }
+	int GetNumberOfClusters() const { return static_cast<int>(mClusterSizes.size()); }
+	long long GetLargestClusterSize() const { return mLargestClusterSize; }
+
+	// 0..GetNumberOfClusters()-1 for an open cell, -1 for a closed one.
+	int GetClusterLabel(int row, int col) const;
+	// size of the cell's cluster, 0 for a closed cell.
+	long long GetClusterSize(int row, int col) const;
+	// are both cells open and in the same cluster?
+	bool Connected(int row1, int col1, int row2, int col2) const;
+};
+
+} /* namespace percolation */
+} /* namespace mabz */
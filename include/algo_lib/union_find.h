@@ -1,48 +1,492 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/frozen_union_find.h>
+
 namespace mabz {
 
+// Throws IndexOutOfRange with a descriptive message. Kept out of line so that
+// the templated classes below don't drag <sstream> into every includer.
+[[noreturn]] void ThrowIndexOutOfRange(long long i, long long capacity);
+
+// Hint that *p will be read soon. Purely a performance hint; never faults.
+inline void PrefetchRead(const void* p)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+	__builtin_prefetch(p);
+#else
+	(void)p;
+#endif
+}
+
+namespace uf_policy {
+
+// Each UnionFind policy is a pair of static rules, resolved at compile time:
+//  - Find(roots, i) returns the root of i, optionally shortening the path on the way.
+//  - Link(roots, sizes, ranks, capacity, rootA, rootB) joins two distinct roots and
+//    returns whichever one survives as the root of the merged tree.
+// "sizes" always holds the true tree size at every root; "ranks" is only allocated
+// for policies that set kUsesRank.
+
+// Plain walk up to the root. Never writes.
+struct NoCompression
+{
+	static int Find(int* roots, int i)
+	{
+		while (i != roots[i]) i = roots[i];
+		return i;
+	}
+};
+
+// Two passes: find the root, then point every node on the path straight at it.
+struct FullCompression
+{
+	static int Find(int* roots, int i)
+	{
+		int root{i};
+		while (root != roots[root]) root = roots[root];
+		while (i != root)
+		{
+			const int next{roots[i]};
+			roots[i] = root;
+			i = next;
+		}
+		return root;
+	}
+};
+
+// One pass: every other node on the path is pointed at its grandparent.
+struct Halving
+{
+	static int Find(int* roots, int i)
+	{
+		while (i != roots[i])
+		{
+			roots[i] = roots[roots[i]];
+			i = roots[i];
+		}
+		return i;
+	}
+};
+
+// One pass: every node on the path is pointed at its grandparent.
+struct Splitting
+{
+	static int Find(int* roots, int i)
+	{
+		while (i != roots[i])
+		{
+			const int next{roots[i]};
+			roots[i] = roots[next];
+			i = next;
+		}
+		return i;
+	}
+};
+
+// link the root of the smaller tree to the root of the larger tree
+struct LinkBySize
+{
+	static constexpr bool kUsesRank{false};
+
+	static int Link(int* roots, const int* sizes, unsigned char*, int, int rootA, int rootB)
+	{
+		if (sizes[rootA] > sizes[rootB])
+		{
+			roots[rootB] = rootA;
+			return rootA;
+		}
+		roots[rootA] = rootB;
+		return rootB;
+	}
+};
+
+// link the root of the shallower tree (by upper bound on height) to the deeper one
+struct LinkByRank
+{
+	static constexpr bool kUsesRank{true};
+
+	static int Link(int* roots, const int*, unsigned char* ranks, int, int rootA, int rootB)
+	{
+		if (ranks[rootA] > ranks[rootB])
+		{
+			roots[rootB] = rootA;
+			return rootA;
+		}
+		if (ranks[rootA] == ranks[rootB]) ++ranks[rootB];
+		roots[rootA] = rootB;
+		return rootB;
+	}
+};
+
+template <typename LinkRule, typename FindRule>
+struct QuickUnion : LinkRule, FindRule {};
+
+// Every node points directly at its root at all times, so Find is a single load
+// and Union relabels the whole of the smaller component: O(capacity) per Union.
+// Only sensible for small inputs; included mainly as a baseline.
+struct QuickFind
+{
+	static constexpr bool kUsesRank{false};
+
+	static int Find(int* roots, int i) { return roots[i]; }
+
+	static int Link(int* roots, const int* sizes, unsigned char*, int capacity, int rootA, int rootB)
+	{
+		if (sizes[rootA] > sizes[rootB])
+		{
+			const int swapVal{rootA};
+			rootA = rootB;
+			rootB = swapVal;
+		}
+		for (int i = 0; i < capacity; ++i)
+		{
+			if (roots[i] == rootA) roots[i] = rootB;
+		}
+		return rootB;
+	}
+};
+
+using WeightedQuickUnion = QuickUnion<LinkBySize, NoCompression>;
+using UnionByRank = QuickUnion<LinkByRank, FullCompression>;
+using PathCompression = QuickUnion<LinkBySize, FullCompression>;
+using PathHalving = QuickUnion<LinkBySize, Halving>;
+using PathSplitting = QuickUnion<LinkBySize, Splitting>;
+
+} /* namespace uf_policy */
+
+using DefaultUnionFindPolicy = uf_policy::PathHalving;
+
+template <typename Policy = DefaultUnionFindPolicy>
 class UnionFind
 {
 private:
 	int mCapacity;
-	// Integer array. The number at position "i" is the index/number of the number i's root. 
+	// Integer array. The number at position "i" is the index/number of i's parent;
+	// following parents eventually reaches a root, which is its own parent.
 	int* mRoots{nullptr};
 	// keep track of the number of nodes in the tree rooted at index "i".
 	int* mTreeSizes{nullptr};
+	// only allocated if the policy links by rank.
+	unsigned char* mRanks{nullptr};
+
+	// Kept up to date by every effective Union, so the queries are O(1).
+	int mComponentCount{0};
+	int mLargestComponentSize{0};
+	// Optional: mSizeHistogram[s] is the number of components of size s.
+	// Empty unless switched on in the constructor.
+	std::vector<int> mSizeHistogram;
+
+	void CheckArrayBounds(int i) const
+	{
+		if (i < 0 || i >= mCapacity) ThrowIndexOutOfRange(i, mCapacity);
+	}
+
+	// Logically const: compressing policies only re-point nodes at ancestors
+	// within the same tree, which can't change the answer to any query.
+	int GetRoot(int i) const { return Policy::Find(mRoots, i); }
+
+	// Expects two distinct roots.
+	void LinkRoots(int rootOfA, int rootOfB)
+	{
+		const int sizeOfA{mTreeSizes[rootOfA]};
+		const int sizeOfB{mTreeSizes[rootOfB]};
+		const int newSize{sizeOfA + sizeOfB};
+
+		const int newRoot{Policy::Link(mRoots, mTreeSizes, mRanks, mCapacity, rootOfA, rootOfB)};
+		mTreeSizes[newRoot] = newSize;
+
+		mComponentCount--;
+		if (newSize > mLargestComponentSize) mLargestComponentSize = newSize;
+		if (!mSizeHistogram.empty())
+		{
+			mSizeHistogram[sizeOfA]--;
+			mSizeHistogram[sizeOfB]--;
+			mSizeHistogram[newSize]++;
+		}
+	}
+
+	// Forget (without freeing) the arrays after they've been moved elsewhere.
+	void Release()
+	{
+		mCapacity = 0;
+		mRoots = nullptr;
+		mTreeSizes = nullptr;
+		mRanks = nullptr;
+		mComponentCount = 0;
+		mLargestComponentSize = 0;
+		mSizeHistogram.clear();
+	}
 
-	void CheckArrayBounds(int) const;
-	int GetRoot(int) const;
+	// How many pairs ahead of the one being processed the batch methods prefetch.
+	static constexpr std::size_t kPrefetchDistance{8};
+
+	void CheckBatchBounds(const std::pair<int,int>* pairs, std::size_t count) const;
+
+	// Two-stage software pipeline used by the batch methods while processing pair i:
+	// the sites of pair i + 2*distance are prefetched, and the (by now cached)
+	// parents of pair i + distance are read so that their parents are prefetched
+	// in turn. By the time pair i's root walks start, the first two levels of
+	// each are already in flight or in cache.
+	void PrefetchPipeline(const std::pair<int,int>* pairs, std::size_t count, std::size_t i) const
+	{
+		if (i + 2*kPrefetchDistance < count)
+		{
+			PrefetchRead(mRoots + pairs[i + 2*kPrefetchDistance].first);
+			PrefetchRead(mRoots + pairs[i + 2*kPrefetchDistance].second);
+		}
+		if (i + kPrefetchDistance < count)
+		{
+			PrefetchRead(mRoots + mRoots[pairs[i + kPrefetchDistance].first]);
+			PrefetchRead(mRoots + mRoots[pairs[i + kPrefetchDistance].second]);
+		}
+	}
 
 public:
-	UnionFind(int capacity) 
+	using policy_type = Policy;
+
+	// trackSizeHistogram costs one more int per site and a few increments per Union.
+	UnionFind(int capacity, bool trackSizeHistogram=false)
 		: mCapacity(capacity)
 		, mRoots(new int[capacity]())
 		, mTreeSizes(new int[capacity]())
-	{ 
-		Reset(); 
+		, mRanks(Policy::kUsesRank ? new unsigned char[capacity]() : nullptr)
+	{
+		if (trackSizeHistogram) mSizeHistogram.resize(capacity + 1);
+		Reset();
 	}
 
-	void Reset() 
-	{ 
-		for (int i = 0; i < mCapacity; i++) 
+	void Reset()
+	{
+		for (int i = 0; i < mCapacity; i++)
 		{
 			mRoots[i] = i;
 			mTreeSizes[i] = 1;
 		}
+		if (mRanks != nullptr)
+		{
+			for (int i = 0; i < mCapacity; i++) mRanks[i] = 0;
+		}
+
+		mComponentCount = mCapacity;
+		mLargestComponentSize = mCapacity > 0 ? 1 : 0;
+		if (!mSizeHistogram.empty())
+		{
+			std::fill(mSizeHistogram.begin(), mSizeHistogram.end(), 0);
+			if (mCapacity > 0) mSizeHistogram[1] = mCapacity;
+		}
+	}
+	~UnionFind()
+	{
+		delete[] mRoots;
+		delete[] mTreeSizes;
+		delete[] mRanks;
 	}
-	~UnionFind() 
-	{ 
-		delete[] mRoots; 
-		delete[] mTreeSizes; 
-	} 
-	
+
 	UnionFind() = delete;
 	UnionFind(const UnionFind&) = delete;
-	UnionFind(UnionFind&&) = delete;
+	UnionFind& operator = (const UnionFind&) = delete;
+
+	// Moving just hands over the arrays; the moved-from object is left empty
+	// (capacity 0), fit only to be destroyed or assigned to.
+	UnionFind(UnionFind&& other)
+		: mCapacity(other.mCapacity)
+		, mRoots(other.mRoots)
+		, mTreeSizes(other.mTreeSizes)
+		, mRanks(other.mRanks)
+		, mComponentCount(other.mComponentCount)
+		, mLargestComponentSize(other.mLargestComponentSize)
+		, mSizeHistogram(std::move(other.mSizeHistogram))
+	{
+		other.Release();
+	}
+
+	UnionFind& operator = (UnionFind&& other)
+	{
+		if (this != &other)
+		{
+			delete[] mRoots;
+			delete[] mTreeSizes;
+			delete[] mRanks;
+			mCapacity = other.mCapacity;
+			mRoots = other.mRoots;
+			mTreeSizes = other.mTreeSizes;
+			mRanks = other.mRanks;
+			mComponentCount = other.mComponentCount;
+			mLargestComponentSize = other.mLargestComponentSize;
+			mSizeHistogram = std::move(other.mSizeHistogram);
+			other.Release();
+		}
+		return *this;
+	}
+
+	// Builds a UnionFind directly from a finished partition: roots[i] is the root
+	// of site i, and every root must be its own root. Each site ends up pointing
+	// straight at its root, so the result starts out fully compressed. O(capacity).
+	// Throws IllegalArgumentException if roots doesn't describe a partition.
+	static UnionFind FromRoots(const std::vector<int>& roots, bool trackSizeHistogram=false);
+
+	int Capacity() const { return mCapacity; }
 
 	void Union(int, int);
 	bool Connected(int, int) const;
+
+	// Unchecked: a and b must be sites, 0 <= a, b < Capacity(). For callers
+	// that have validated their sites once up front and Union or ask about
+	// them in a hot loop, such as the percolation trial loops.
+	void UnionUnchecked(int a, int b)
+	{
+		const int rootOfA{GetRoot(a)};
+		const int rootOfB{GetRoot(b)};
+		if (rootOfA != rootOfB) LinkRoots(rootOfA, rootOfB);
+	}
+
+	bool ConnectedUnchecked(int a, int b) const { return GetRoot(a) == GetRoot(b); }
+
+	// Root of the component containing i.
+	int Find(int i) const
+	{
+		CheckArrayBounds(i);
+		return GetRoot(i);
+	}
+
+	int ComponentCount() const { return mComponentCount; }
+	int LargestComponentSize() const { return mLargestComponentSize; }
+
+	// Number of sites in the component containing i.
+	int ComponentSize(int i) const { return mTreeSizes[Find(i)]; }
+
+	bool HasSizeHistogram() const { return !mSizeHistogram.empty(); }
+
+	// Element s is the number of components with exactly s sites (element 0 is
+	// always 0). Throws UnexpectedMethodCall unless constructed with trackSizeHistogram.
+	const std::vector<int>& SizeHistogram() const
+	{
+		if (mSizeHistogram.empty())
+		{
+			throw mabz::UnexpectedMethodCall("UnionFind wasn't constructed to track a size histogram.");
+		}
+		return mSizeHistogram;
+	}
+
+	// Flattens every site to point directly at its root and returns the labels as
+	// an immutable FrozenUnionFind, for the read-mostly phase after building.
+	// This UnionFind is unchanged (apart from compression) and still usable. O(capacity).
+	FrozenUnionFind Freeze() const
+	{
+		std::vector<int> labels(mCapacity);
+		for (int i = 0; i < mCapacity; i++)
+		{
+			labels[i] = GetRoot(i);
+			mRoots[i] = labels[i];
+		}
+		return FrozenUnionFind(std::move(labels), mComponentCount);
+	}
+
+	// Same as calling Union/Connected on each pair in turn, but the parent reads of
+	// upcoming pairs are prefetched so that their cache misses overlap with the
+	// current pair's work, which pays off once the arrays are much bigger than the
+	// cache. Every index in the batch is checked before anything is done, so if
+	// this throws the structure is unchanged.
+	// outConnected must have room for count results.
+	void UnionBatch(const std::pair<int,int>* pairs, std::size_t count);
+	void ConnectedBatch(const std::pair<int,int>* pairs, std::size_t count, bool* outConnected) const;
 };
 
-} /* namespace mabz */
\ No newline at end of file
+template <typename Policy>
+UnionFind<Policy> UnionFind<Policy>::FromRoots(const std::vector<int>& roots, bool trackSizeHistogram)
+{
+	const int capacity = static_cast<int>(roots.size());
+	UnionFind uf(capacity, trackSizeHistogram);
+
+	for (int i = 0; i < capacity; i++)
+	{
+		const int root{roots[i]};
+		if (root < 0 || root >= capacity || roots[root] != root)
+		{
+			throw mabz::IllegalArgumentException("UnionFind::FromRoots given a site whose root isn't a root.");
+		}
+		if (root == i) continue;
+
+		uf.mRoots[i] = root;
+		uf.mTreeSizes[root]++;
+		uf.mComponentCount--;
+		if (uf.mRanks != nullptr) uf.mRanks[root] = 1;
+	}
+
+	uf.mLargestComponentSize = capacity > 0 ? 1 : 0;
+	if (uf.HasSizeHistogram() && capacity > 0) uf.mSizeHistogram[1] = 0;
+	for (int i = 0; i < capacity; i++)
+	{
+		if (roots[i] != i) continue;
+		const int size{uf.mTreeSizes[i]};
+		if (size > uf.mLargestComponentSize) uf.mLargestComponentSize = size;
+		if (uf.HasSizeHistogram()) uf.mSizeHistogram[size]++;
+	}
+	return uf;
+}
+
+template <typename Policy>
+void UnionFind<Policy>::Union(int a, int b)
+{
+	CheckArrayBounds(a);
+	CheckArrayBounds(b);
+	UnionUnchecked(a, b);
+}
+
+template <typename Policy>
+bool UnionFind<Policy>::Connected(int a, int b) const
+{
+	CheckArrayBounds(a);
+	CheckArrayBounds(b);
+	return ConnectedUnchecked(a, b);
+}
+
+template <typename Policy>
+void UnionFind<Policy>::CheckBatchBounds(const std::pair<int,int>* pairs, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; i++)
+	{
+		CheckArrayBounds(pairs[i].first);
+		CheckArrayBounds(pairs[i].second);
+	}
+}
+
+template <typename Policy>
+void UnionFind<Policy>::UnionBatch(const std::pair<int,int>* pairs, std::size_t count)
+{
+	CheckBatchBounds(pairs, count);
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		PrefetchPipeline(pairs, count, i);
+		const int rootOfA{GetRoot(pairs[i].first)};
+		const int rootOfB{GetRoot(pairs[i].second)};
+		if (rootOfA != rootOfB) LinkRoots(rootOfA, rootOfB);
+	}
+}
+
+template <typename Policy>
+void UnionFind<Policy>::ConnectedBatch(const std::pair<int,int>* pairs, std::size_t count, bool* outConnected) const
+{
+	CheckBatchBounds(pairs, count);
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		PrefetchPipeline(pairs, count, i);
+		outConnected[i] = GetRoot(pairs[i].first) == GetRoot(pairs[i].second);
+	}
+}
+
+} /* namespace mabz */
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "algo_lib/bond_percolation.h"
+#include "algo_lib/exceptions.h"
+#include "algo_lib/running_stats.h"
+
+namespace mabz { namespace percolation {
+
+BondPercolationStats::BondPercolationStats(int n, int trials)
+{
+	if (n < 2 || trials <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct BondPercolationStats with n >= 2 and positive trials. "
+		    << "Instead, got n: " << n << " and trials: " << trials;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	BondPercolation percolation(n);
+	const double bondCount = percolation.BondCount();
+
+	// ids of every real bond, see BasicBondPercolation; reshuffled each trial.
+	std::vector<int> bondIds;
+	bondIds.reserve(percolation.BondCount());
+	for (int site = 0; site < n*n; site++)
+	{
+		if (site % n != n-1) bondIds.push_back(2*site);
+		if (site < n*(n-1)) bondIds.push_back(2*site + 1);
+	}
+
+	mabz::RunningStats stats;
+
+	auto randEng = std::default_random_engine{};
+
+	for (int i = 0; i < trials; i++)
+	{
+		std::shuffle(std::begin(bondIds), std::end(bondIds), randEng);
+		percolation.ResetGrid();
+
+		int iterCount = 1;
+		for (int id : bondIds)
+		{
+			percolation.OpenBondUnchecked(id);
+			if (percolation.DoesPercolate())
+			{
+				stats.Add(iterCount / bondCount);
+				break;
+			}
+
+			iterCount++;
+		}
+	}
+
+	mMean = stats.Mean();
+	mStdev = stats.Stdev();
+	mConfidenceLow = mMean - stats.HalfWidth95();
+	mConfidenceHigh = mMean + stats.HalfWidth95();
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
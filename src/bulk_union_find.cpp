@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algo_lib/bulk_union_find.h"
+#include "algo_lib/concurrent_union_find.h"
+#include "algo_lib/exceptions.h"
+#include "algo_lib/memory_mapped_file.h"
+#include "algo_lib/parallel.h"
+
+namespace mabz {
+
+namespace {
+
+// Shared by both entry points; edgeAt(i) returns the i'th edge as a pair.
+template <typename EdgeAt>
+std::vector<int> LinkAndCollectRoots(int capacity, std::size_t edgeCount, int threadCount, EdgeAt edgeAt)
+{
+	if (capacity < 0)
+	{
+		std::stringstream err;
+		err << "Capacity must not be negative. Instead got " << capacity;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	ConcurrentUnionFind connections(capacity);
+
+	// Bounds are checked per edge by ConcurrentUnionFind::Union; ParallelFor
+	// carries the exception back to this thread.
+	ParallelFor(edgeCount, threadCount, [&](int, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+		{
+			const std::pair<int,int> edge = edgeAt(i);
+			connections.Union(edge.first, edge.second);
+		}
+	});
+
+	// All links are done, so finding roots can't race with anything.
+	std::vector<int> roots(capacity);
+	ParallelFor(static_cast<std::size_t>(capacity), threadCount, [&](int, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+		{
+			roots[i] = connections.Find(static_cast<int>(i));
+		}
+	});
+	return roots;
+}
+
+} /* anon namespace */
+
+std::vector<int> ParallelComponentRoots(int capacity, const std::pair<int,int>* edges,
+	std::size_t edgeCount, int threadCount)
+{
+	return LinkAndCollectRoots(capacity, edgeCount, threadCount,
+		[edges](std::size_t i) { return edges[i]; });
+}
+
+std::vector<int> ParallelComponentRootsFromFile(int capacity, const std::string& path, int threadCount)
+{
+	MemoryMappedFile file(path, false);
+	const std::size_t edgeBytes = 2 * sizeof(std::int32_t);
+	if (file.Size() % edgeBytes != 0)
+	{
+		std::stringstream err;
+		err << "Edge list file \"" << path << "\" is " << file.Size()
+			<< " bytes, which isn't a whole number of int32 pairs.";
+		throw mabz::FileError(err.str());
+	}
+
+	const std::int32_t* ends = static_cast<const std::int32_t*>(file.Data());
+	return LinkAndCollectRoots(capacity, file.Size() / edgeBytes, threadCount,
+		[ends](std::size_t i) { return std::make_pair(static_cast<int>(ends[2*i]), static_cast<int>(ends[2*i + 1])); });
+}
+
+} /* namespace mabz */
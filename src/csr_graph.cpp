@@ -0,0 +1,177 @@
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algo_lib/csr_graph.h"
+#include "algo_lib/exceptions.h"
+#include "algo_lib/memory_mapped_file.h"
+
+namespace mabz {
+
+namespace {
+
+const char kMagic[8] = {'M', 'A', 'B', 'Z', 'C', 'S', 'R', 'G'};
+const std::uint32_t kVersion{1};
+
+} /* anon namespace */
+
+void CsrGraph::Validate(const std::vector<std::uint64_t>& offsets, const std::vector<int>& neighbours)
+{
+	if (offsets.empty() || offsets.size() - 1 > static_cast<std::size_t>(INT_MAX - 2))
+	{
+		std::stringstream err;
+		err << "CSR offsets must have between 1 and " << INT_MAX - 1 << " entries. Got " << offsets.size();
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	if (offsets.front() != 0 || offsets.back() != neighbours.size())
+	{
+		std::stringstream err;
+		err << "CSR offsets must run from 0 to the number of neighbours, " << neighbours.size()
+		    << ". Got " << offsets.front() << " to " << offsets.back();
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	for (std::size_t v = 0; v + 1 < offsets.size(); v++)
+	{
+		if (offsets[v] > offsets[v+1])
+		{
+			std::stringstream err;
+			err << "CSR offsets must not decrease. Vertex " << v << " has offsets "
+			    << offsets[v] << " then " << offsets[v+1];
+			throw mabz::IllegalArgumentException(err.str());
+		}
+	}
+
+	// one branch-free pass: any negative or too big neighbour sets the flag.
+	const unsigned vertexCount = static_cast<unsigned>(offsets.size() - 1);
+	bool anyOutOfRange{false};
+	for (int neighbour : neighbours)
+	{
+		anyOutOfRange |= static_cast<unsigned>(neighbour) >= vertexCount;
+	}
+	if (anyOutOfRange)
+	{
+		std::stringstream err;
+		err << "CSR neighbours must all be vertices between 0 and " << vertexCount << " exclusive.";
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+CsrGraph::CsrGraph(std::vector<std::uint64_t> offsets, std::vector<int> neighbours)
+{
+	Validate(offsets, neighbours);
+	mOffsets = std::move(offsets);
+	mNeighbours = std::move(neighbours);
+}
+
+CsrGraph CsrGraph::FromEdges(int vertexCount, const std::vector<std::pair<int,int> >& edges)
+{
+	if (vertexCount < 0 || vertexCount > INT_MAX - 2)
+	{
+		std::stringstream err;
+		err << "Vertex count must be between 0 and " << INT_MAX - 2 << ". Got " << vertexCount;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	for (const auto& edge : edges)
+	{
+		if (edge.first < 0 || edge.first >= vertexCount || edge.second < 0 || edge.second >= vertexCount)
+		{
+			std::stringstream err;
+			err << "Edge (" << edge.first << ", " << edge.second << ") has an endpoint outside 0.."
+			    << vertexCount - 1;
+			throw mabz::IllegalArgumentException(err.str());
+		}
+	}
+
+	// counting sort by source vertex: degrees, prefix sums, then scatter.
+	std::vector<std::uint64_t> offsets(vertexCount + 1, 0);
+	for (const auto& edge : edges)
+	{
+		offsets[edge.first + 1]++;
+		if (edge.second != edge.first) offsets[edge.second + 1]++;
+	}
+	for (int v = 0; v < vertexCount; v++) offsets[v+1] += offsets[v];
+
+	std::vector<int> neighbours(offsets.back());
+	std::vector<std::uint64_t> next(offsets.begin(), offsets.end() - 1);
+	for (const auto& edge : edges)
+	{
+		neighbours[next[edge.first]++] = edge.second;
+		if (edge.second != edge.first) neighbours[next[edge.second]++] = edge.first;
+	}
+
+	CsrGraph graph;
+	graph.mOffsets = std::move(offsets);
+	graph.mNeighbours = std::move(neighbours);
+	return graph;
+}
+
+CsrGraph CsrGraph::Load(const std::string& path)
+{
+	MemoryMappedFile file(path, false);
+
+	CsrGraphFileHeader header;
+	if (file.Size() < sizeof(header))
+	{
+		throw mabz::FileError("Too small to be a CSR graph: \"" + path + "\".");
+	}
+	std::memcpy(&header, file.Data(), sizeof(header));
+	if (std::memcmp(header.mMagic, kMagic, sizeof(kMagic)) != 0 || header.mVersion != kVersion)
+	{
+		throw mabz::FileError("Not a CSR graph (or an unsupported version): \"" + path + "\".");
+	}
+
+	// checked one term at a time so silly counts can't overflow the sum.
+	const std::uint64_t available = file.Size() - sizeof(header);
+	const bool fits = header.mVertices < available / sizeof(std::uint64_t)
+		&& header.mAdjacencies <= (available - (header.mVertices + 1) * sizeof(std::uint64_t)) / sizeof(std::int32_t)
+		&& available == (header.mVertices + 1) * sizeof(std::uint64_t) + header.mAdjacencies * sizeof(std::int32_t);
+	if (!fits)
+	{
+		std::stringstream err;
+		err << "CSR graph \"" << path << "\" claims " << header.mVertices << " vertices and "
+		    << header.mAdjacencies << " neighbours, which doesn't match its size of " << file.Size() << " bytes.";
+		throw mabz::FileError(err.str());
+	}
+
+	const char* data = static_cast<const char*>(file.Data()) + sizeof(header);
+	std::vector<std::uint64_t> offsets(header.mVertices + 1);
+	std::memcpy(offsets.data(), data, offsets.size() * sizeof(std::uint64_t));
+	data += offsets.size() * sizeof(std::uint64_t);
+	std::vector<int> neighbours(header.mAdjacencies);
+	static_assert(sizeof(int) == sizeof(std::int32_t), "CSR files store neighbours as int32");
+	std::memcpy(neighbours.data(), data, neighbours.size() * sizeof(std::int32_t));
+
+	try
+	{
+		return CsrGraph(std::move(offsets), std::move(neighbours));
+	}
+	catch (const mabz::IllegalArgumentException& ex)
+	{
+		throw mabz::FileError("Malformed CSR graph \"" + path + "\": " + ex.what());
+	}
+}
+
+void CsrGraph::Save(const std::string& path) const
+{
+	CsrGraphFileHeader header{};
+	std::memcpy(header.mMagic, kMagic, sizeof(kMagic));
+	header.mVersion = kVersion;
+	header.mVertices = mOffsets.size() - 1;
+	header.mAdjacencies = mNeighbours.size();
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(mOffsets.data()), mOffsets.size() * sizeof(std::uint64_t));
+	out.write(reinterpret_cast<const char*>(mNeighbours.data()), mNeighbours.size() * sizeof(std::int32_t));
+	out.close();
+	if (!out)
+	{
+		throw mabz::FileError("Could not write CSR graph to \"" + path + "\".");
+	}
+}
+
+} /* namespace mabz */
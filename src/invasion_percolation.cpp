@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "algo_lib/exceptions.h"
+#include "algo_lib/invasion_percolation.h"
+#include "algo_lib/running_stats.h"
+
+namespace mabz { namespace percolation {
+
+InvasionPercolation::InvasionPercolation(int n)
+	: mN(n)
+	, mInvaded(n > 0 ? n : 0, n > 0 ? n : 0)
+	, mSeen(n > 0 ? n : 0, n > 0 ? n : 0)
+{
+	if (n <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct InvasionPercolation class with n > 0. Instead got " << n;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+double InvasionPercolation::Run(std::uint64_t seed)
+{
+	const int n{mN};
+	mInvaded.ClearAll();
+	mSeen.ClearAll();
+	mFrontier.clear();
+	mThreshold = 0;
+
+	std::mt19937_64 randEng(seed);
+	std::uniform_real_distribution<double> weightDist(0.0, 1.0);
+	// min-heap: std heap functions keep the LARGEST at the front, so flip it.
+	auto heavier = [](const FrontierCell& a, const FrontierCell& b) { return a.mWeight > b.mWeight; };
+
+	auto addToFrontier = [&](int row, int col) {
+		if (!mSeen.Set(row, col)) return;
+		mFrontier.push_back(FrontierCell{weightDist(randEng), row * n + col});
+		std::push_heap(mFrontier.begin(), mFrontier.end(), heavier);
+	};
+
+	for (int col = 0; col < n; col++)
+	{
+		addToFrontier(0, col);
+	}
+
+	while (!mFrontier.empty())
+	{
+		std::pop_heap(mFrontier.begin(), mFrontier.end(), heavier);
+		const FrontierCell next = mFrontier.back();
+		mFrontier.pop_back();
+
+		const int row{next.mCell / n};
+		const int col{next.mCell % n};
+		mInvaded.Set(row, col);
+		mThreshold = std::max(mThreshold, next.mWeight);
+		if (row == n-1) break;
+
+		if (col > 0) addToFrontier(row, col-1);
+		if (col < n-1) addToFrontier(row, col+1);
+		if (row > 0) addToFrontier(row-1, col);
+		addToFrontier(row+1, col);
+	}
+
+	return mThreshold;
+}
+
+bool InvasionPercolation::IsInvaded(int row, int col) const
+{
+	if (row < 1 || row > mN || col < 1 || col > mN)
+	{
+		std::stringstream err;
+		err << "Row and col indices must be between 1 and " << mN << " inclusive. Got "
+		    << row << ", " << col;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	return mInvaded.Get(row-1, col-1);
+}
+
+InvasionPercolationStats::InvasionPercolationStats(int n, int trials)
+{
+	if (n <= 0 || trials <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct InvasionPercolationStats with positive n and trials. "
+		    << "Instead, got n: " << n << " and trials: " << trials;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	InvasionPercolation invasion(n);
+	mabz::RunningStats stats;
+	for (int i = 0; i < trials; i++)
+	{
+		stats.Add(invasion.Run(i));
+	}
+
+	mMean = stats.Mean();
+	mStdev = stats.Stdev();
+	mConfidenceLow = mMean - stats.HalfWidth95();
+	mConfidenceHigh = mMean + stats.HalfWidth95();
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,231 @@
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "algo_lib/exceptions.h"
+#include "algo_lib/memory_mapped_file.h"
+
+namespace mabz {
+
+namespace {
+
+[[noreturn]] void ThrowFileError(const std::string& what, const std::string& path)
+{
+	std::stringstream err;
+	err << what << " \"" << path << "\". ";
+#ifdef _WIN32
+	err << "Windows error code: " << GetLastError();
+#else
+	err << "Reason: " << std::strerror(errno);
+#endif
+	throw mabz::FileError(err.str());
+}
+
+#ifdef _WIN32
+HANDLE AsHandle(std::intptr_t h) { return reinterpret_cast<HANDLE>(h); }
+std::intptr_t FromHandle(HANDLE h) { return reinterpret_cast<std::intptr_t>(h); }
+#endif
+
+} /* anon namespace */
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path, bool writable)
+	: mWritable(writable)
+{
+	HANDLE file = CreateFileA(path.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+		FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) ThrowFileError("Could not open", path);
+	mFile = FromHandle(file);
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		Close();
+		ThrowFileError("Could not get size of", path);
+	}
+	mSize = static_cast<std::size_t>(size.QuadPart);
+	if (mSize == 0)
+	{
+		Close();
+		throw mabz::FileError("Cannot map empty file \"" + path + "\".");
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		Close();
+		ThrowFileError("Could not create file mapping for", path);
+	}
+	mMapping = FromHandle(mapping);
+
+	mData = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+	if (mData == nullptr)
+	{
+		Close();
+		ThrowFileError("Could not map view of", path);
+	}
+}
+
+MemoryMappedFile MemoryMappedFile::Create(const std::string& path, std::size_t sizeInBytes)
+{
+	if (sizeInBytes == 0)
+	{
+		throw mabz::IllegalArgumentException("Cannot create an empty memory mapped file.");
+	}
+
+	// create/truncate and size the file, then map it like any other.
+	{
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+			CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) ThrowFileError("Could not create", path);
+		LARGE_INTEGER size;
+		size.QuadPart = static_cast<LONGLONG>(sizeInBytes);
+		const bool ok = SetFilePointerEx(file, size, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+		CloseHandle(file);
+		if (!ok) ThrowFileError("Could not resize", path);
+	}
+	return MemoryMappedFile(path, true);
+}
+
+void MemoryMappedFile::Close()
+{
+	if (mData != nullptr) UnmapViewOfFile(mData);
+	if (mMapping != -1 && mMapping != 0) CloseHandle(AsHandle(mMapping));
+	if (mFile != -1) CloseHandle(AsHandle(mFile));
+	mData = nullptr;
+	mMapping = -1;
+	mFile = -1;
+	mSize = 0;
+}
+
+void MemoryMappedFile::Flush()
+{
+	if (mData == nullptr || !mWritable) return;
+	if (!FlushViewOfFile(mData, 0) || !FlushFileBuffers(AsHandle(mFile)))
+	{
+		ThrowFileError("Could not flush", "memory mapped file");
+	}
+}
+
+void MemoryMappedFile::AdviseRandomAccess() {}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path, bool writable)
+	: mWritable(writable)
+{
+	const int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+	if (fd < 0) ThrowFileError("Could not open", path);
+	mFile = fd;
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0)
+	{
+		Close();
+		ThrowFileError("Could not get size of", path);
+	}
+	mSize = static_cast<std::size_t>(info.st_size);
+	if (mSize == 0)
+	{
+		Close();
+		throw mabz::FileError("Cannot map empty file \"" + path + "\".");
+	}
+
+	void* data = ::mmap(nullptr, mSize, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	if (data == MAP_FAILED)
+	{
+		Close();
+		ThrowFileError("Could not map", path);
+	}
+	mData = data;
+}
+
+MemoryMappedFile MemoryMappedFile::Create(const std::string& path, std::size_t sizeInBytes)
+{
+	if (sizeInBytes == 0)
+	{
+		throw mabz::IllegalArgumentException("Cannot create an empty memory mapped file.");
+	}
+
+	// create/truncate and size the file, then map it like any other.
+	{
+		const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) ThrowFileError("Could not create", path);
+		const bool ok = ::ftruncate(fd, static_cast<off_t>(sizeInBytes)) == 0;
+		::close(fd);
+		if (!ok) ThrowFileError("Could not resize", path);
+	}
+	return MemoryMappedFile(path, true);
+}
+
+void MemoryMappedFile::Close()
+{
+	if (mData != nullptr) ::munmap(mData, mSize);
+	if (mFile != -1) ::close(static_cast<int>(mFile));
+	mData = nullptr;
+	mFile = -1;
+	mSize = 0;
+}
+
+void MemoryMappedFile::Flush()
+{
+	if (mData == nullptr || !mWritable) return;
+	if (::msync(mData, mSize, MS_SYNC) != 0)
+	{
+		ThrowFileError("Could not flush", "memory mapped file");
+	}
+}
+
+void MemoryMappedFile::AdviseRandomAccess()
+{
+	if (mData != nullptr) ::madvise(mData, mSize, MADV_RANDOM);
+}
+
+#endif
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other)
+	: mData(other.mData)
+	, mSize(other.mSize)
+	, mWritable(other.mWritable)
+	, mFile(other.mFile)
+	, mMapping(other.mMapping)
+{
+	other.mData = nullptr;
+	other.mSize = 0;
+	other.mFile = -1;
+	other.mMapping = -1;
+}
+
+MemoryMappedFile& MemoryMappedFile::operator = (MemoryMappedFile&& other)
+{
+	if (this != &other)
+	{
+		Close();
+		mData = other.mData;
+		mSize = other.mSize;
+		mWritable = other.mWritable;
+		mFile = other.mFile;
+		mMapping = other.mMapping;
+		other.mData = nullptr;
+		other.mSize = 0;
+		other.mFile = -1;
+		other.mMapping = -1;
+	}
+	return *this;
+}
+
+} /* namespace mabz */
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "algo_lib/bit_grid.h"
+#include "algo_lib/exceptions.h"
+#include "algo_lib/newman_ziff.h"
+#include "algo_lib/union_find.h"
+
+namespace mabz { namespace percolation {
+
+NewmanZiff::NewmanZiff(int n, int runs, std::uint64_t seed)
+	: mN(n)
+	, mRuns(runs)
+{
+	if (n <= 0 || runs <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct NewmanZiff with positive n and runs. "
+		    << "Instead, got n: " << n << " and runs: " << runs;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	// occupations run 0..n^2, all counted in int.
+	if (static_cast<long long>(n) * n + 1 > INT_MAX)
+	{
+		std::stringstream err;
+		err << "Must construct NewmanZiff with n <= 46340. Instead got " << n;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	mByOccupation.resize(n*n + 1);
+
+	std::vector<int> order(n*n);
+	for (int run = 0; run < runs; run++)
+	{
+		RunOnce(order, seed + run);
+	}
+
+	for (auto& obs : mByOccupation)
+	{
+		obs.mSpanning /= runs;
+		obs.mLargestClusterFraction /= runs;
+		obs.mMeanClusterSize /= runs;
+	}
+}
+
+void NewmanZiff::RunOnce(std::vector<int>& order, std::uint64_t seed)
+{
+	const int n{mN};
+	const int cells{n * n};
+
+	std::iota(order.begin(), order.end(), 0);
+	std::mt19937_64 randEng(seed);
+	std::shuffle(order.begin(), order.end(), randEng);
+
+	mabz::UnionFind<> clusters(cells);
+	mabz::BitGrid open(n, n);
+	// whether the cluster rooted at a cell touches the top/bottom row; only
+	// meaningful at roots.
+	std::vector<unsigned char> touches(cells, 0);
+	const unsigned char kTop{1};
+	const unsigned char kBottom{2};
+
+	bool spanning{false};
+	// sum of the squares of all open cluster sizes.
+	double sumSquares{0};
+
+	// joins the clusters of two open cells, keeping sumSquares and touches right.
+	auto join = [&](int a, int b) {
+		const int rootOfA{clusters.Find(a)};
+		const int rootOfB{clusters.Find(b)};
+		if (rootOfA == rootOfB) return;
+
+		const double sizeOfA = clusters.ComponentSize(rootOfA);
+		const double sizeOfB = clusters.ComponentSize(rootOfB);
+		const unsigned char touchesEither = touches[rootOfA] | touches[rootOfB];
+
+		clusters.Union(rootOfA, rootOfB);
+		const int newRoot{clusters.Find(rootOfA)};
+		touches[newRoot] = touchesEither;
+		sumSquares += 2 * sizeOfA * sizeOfB;
+		if (touchesEither == (kTop | kBottom)) spanning = true;
+	};
+
+	for (int occupied = 1; occupied <= cells; occupied++)
+	{
+		const int cell{order[occupied - 1]};
+		const int row{cell / n};
+		const int col{cell % n};
+
+		open.Set(row, col);
+		sumSquares += 1;
+		touches[cell] = (row == 0 ? kTop : 0) | (row == n-1 ? kBottom : 0);
+		if (touches[cell] == (kTop | kBottom)) spanning = true;
+
+		if (col > 0 && open.Get(row, col-1)) join(cell, cell-1);
+		if (col < n-1 && open.Get(row, col+1)) join(cell, cell+1);
+		if (row > 0 && open.Get(row-1, col)) join(cell, cell-n);
+		if (row < n-1 && open.Get(row+1, col)) join(cell, cell+n);
+
+		// closed cells are singleton components of the union-find too, but the
+		// largest is never smaller than 1 once anything is open.
+		const double largest = clusters.LargestComponentSize();
+		const double othersSize = occupied - largest;
+		const double othersSquares = sumSquares - largest*largest;
+
+		Observables& obs = mByOccupation[occupied];
+		obs.mSpanning += spanning ? 1 : 0;
+		obs.mLargestClusterFraction += largest / cells;
+		obs.mMeanClusterSize += othersSize > 0 ? othersSquares / othersSize : 0;
+	}
+}
+
+const NewmanZiff::Observables& NewmanZiff::AtOccupation(int occupied) const
+{
+	if (occupied < 0 || occupied > Cells())
+	{
+		std::stringstream err;
+		err << "Occupation number must be between 0 and " << Cells() << " inclusive. Got " << occupied;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	return mByOccupation[occupied];
+}
+
+NewmanZiff::Observables NewmanZiff::At(double p) const
+{
+	const std::vector<double> weights = BinomialWeights(Cells(), p);
+
+	Observables result;
+	for (int occupied = 0; occupied <= Cells(); occupied++)
+	{
+		const double w = weights[occupied];
+		if (w == 0) continue;
+		result.mSpanning += w * mByOccupation[occupied].mSpanning;
+		result.mLargestClusterFraction += w * mByOccupation[occupied].mLargestClusterFraction;
+		result.mMeanClusterSize += w * mByOccupation[occupied].mMeanClusterSize;
+	}
+	return result;
+}
+
+std::vector<double> NewmanZiff::BinomialWeights(int cells, double p)
+{
+	if (cells < 0 || !(p >= 0 && p <= 1))
+	{
+		std::stringstream err;
+		err << "BinomialWeights needs cells >= 0 and p in [0, 1]. Got cells: " << cells << " and p: " << p;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	std::vector<double> weights(cells + 1, 0.0);
+	if (p == 0 || p == 1)
+	{
+		weights[p == 0 ? 0 : cells] = 1;
+		return weights;
+	}
+
+	// Ratios between neighbouring terms, starting from 1 at the mode, so nothing
+	// over- or underflows until it's negligible anyway.
+	const int mode = std::min(cells, static_cast<int>(std::floor((cells + 1) * p)));
+	const double odds = p / (1 - p);
+	const double kNegligible{1e-15};
+
+	weights[mode] = 1;
+	double total{1};
+	for (int k = mode; k < cells; k++)
+	{
+		const double next = weights[k] * odds * (cells - k) / (k + 1);
+		if (next < kNegligible) break;
+		weights[k + 1] = next;
+		total += next;
+	}
+	for (int k = mode; k > 0; k--)
+	{
+		const double next = weights[k] / odds * k / (cells - k + 1);
+		if (next < kNegligible) break;
+		weights[k - 1] = next;
+		total += next;
+	}
+
+	for (auto& w : weights) w /= total;
+	return weights;
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
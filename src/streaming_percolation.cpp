@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "algo_lib/exceptions.h"
+#include "algo_lib/streaming_percolation.h"
+
+namespace mabz { namespace percolation {
+
+StreamingPercolation::StreamingPercolation(int width)
+	: mWidth(width)
+	, mLabels(width > 0 ? 2 * width : 0)
+{
+	if (width <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct StreamingPercolation with a positive width. Instead, got: " << width;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	mClusterSizes.resize(2 * width, 0);
+	mTouchesTop.resize(2 * width, 0);
+	mPreviousRow.resize(width, -1);
+	mRenumber.resize(2 * width, -1);
+	mSizeScratch.resize(width, 0);
+	mTopScratch.resize(width, 0);
+}
+
+void StreamingPercolation::CheckNotFinished() const
+{
+	if (mFinished)
+	{
+		throw mabz::UnexpectedMethodCall("Cannot add rows to a StreamingPercolation after Finish().");
+	}
+}
+
+void StreamingPercolation::CheckFinished() const
+{
+	if (!mFinished)
+	{
+		throw mabz::UnexpectedMethodCall("StreamingPercolation results are only available after Finish().");
+	}
+}
+
+void StreamingPercolation::FinishCluster(long long size)
+{
+	mClusterCount++;
+	mLargestClusterSize = std::max(mLargestClusterSize, size);
+}
+
+void StreamingPercolation::AddRow(const unsigned char* cells)
+{
+	CheckNotFinished();
+	const int w{mWidth};
+	const int carried{mCarried};
+	const bool isTopRow{mRows == 0};
+
+	mLabels.Reset();
+
+	// joins two labels, adding up sizes and top flags at the new root.
+	auto join = [this](int a, int b) {
+		const int rootOfA{mLabels.Find(a)};
+		const int rootOfB{mLabels.Find(b)};
+		if (rootOfA == rootOfB) return;
+
+		const long long size{mClusterSizes[rootOfA] + mClusterSizes[rootOfB]};
+		const unsigned char top = mTouchesTop[rootOfA] | mTouchesTop[rootOfB];
+		mLabels.Union(rootOfA, rootOfB);
+		const int newRoot{mLabels.Find(rootOfA)};
+		mClusterSizes[newRoot] = size;
+		mTouchesTop[newRoot] = top;
+	};
+
+	for (int c = 0; c < w; c++)
+	{
+		if (!cells[c]) continue;
+
+		const int label{carried + c};
+		mClusterSizes[label] = 1;
+		mTouchesTop[label] = isTopRow ? 1 : 0;
+		mOpenSites++;
+
+		if (c > 0 && cells[c-1]) join(label, label - 1);
+		if (mPreviousRow[c] >= 0) join(label, mPreviousRow[c]);
+	}
+
+	// renumber the clusters that reach this row as 0..k-1, in order of first cell.
+	int next{0};
+	for (int c = 0; c < w; c++)
+	{
+		if (!cells[c])
+		{
+			mPreviousRow[c] = -1;
+			continue;
+		}
+		const int root{mLabels.Find(carried + c)};
+		if (mRenumber[root] < 0)
+		{
+			mRenumber[root] = next++;
+		}
+		mPreviousRow[c] = mRenumber[root];
+	}
+
+	// clusters carried in from the row above that didn't reach this one are done.
+	for (int label = 0; label < carried; label++)
+	{
+		if (mLabels.Find(label) == label && mRenumber[label] < 0)
+		{
+			FinishCluster(mClusterSizes[label]);
+		}
+	}
+
+	// gather the surviving clusters' data by new number, then move it down.
+	for (int c = 0; c < w; c++)
+	{
+		if (!cells[c]) continue;
+		const int root{mLabels.Find(carried + c)};
+		const int newLabel{mRenumber[root]};
+		if (newLabel < 0) continue;
+		mSizeScratch[newLabel] = mClusterSizes[root];
+		mTopScratch[newLabel] = mTouchesTop[root];
+		mRenumber[root] = -1;
+	}
+	std::copy(mSizeScratch.begin(), mSizeScratch.begin() + next, mClusterSizes.begin());
+	std::copy(mTopScratch.begin(), mTopScratch.begin() + next, mTouchesTop.begin());
+
+	mCarried = next;
+	mRows++;
+}
+
+void StreamingPercolation::AddPackedRow(const unsigned char* bits)
+{
+	CheckNotFinished();
+	mRowScratch.resize(mWidth);
+	for (int c = 0; c < mWidth; c++)
+	{
+		mRowScratch[c] = (bits[c >> 3] >> (c & 7)) & 1;
+	}
+	AddRow(mRowScratch.data());
+}
+
+void StreamingPercolation::Finish()
+{
+	CheckNotFinished();
+	// everything still alive reaches the bottom row.
+	for (int label = 0; label < mCarried; label++)
+	{
+		FinishCluster(mClusterSizes[label]);
+		if (mTouchesTop[label]) mPercolates = true;
+	}
+	mCarried = 0;
+	mFinished = true;
+}
+
+bool StreamingPercolation::DoesPercolate() const
+{
+	CheckFinished();
+	return mPercolates;
+}
+
+long long StreamingPercolation::GetNumberOfOpenSites() const
+{
+	CheckFinished();
+	return mOpenSites;
+}
+
+long long StreamingPercolation::GetNumberOfClusters() const
+{
+	CheckFinished();
+	return mClusterCount;
+}
+
+long long StreamingPercolation::GetLargestClusterSize() const
+{
+	CheckFinished();
+	return mLargestClusterSize;
+}
+
+StreamingPercolation StreamingPercolation::Analyze(int width, long long rows,
+	const std::function<void(long long, unsigned char*)>& generator)
+{
+	StreamingPercolation result(width);
+	std::vector<unsigned char> cells(width);
+	for (long long row = 0; row < rows; row++)
+	{
+		std::fill(cells.begin(), cells.end(), 0);
+		generator(row, cells.data());
+		result.AddRow(cells.data());
+	}
+	result.Finish();
+	return result;
+}
+
+StreamingPercolation StreamingPercolation::AnalyzeFile(int width, const std::string& path)
+{
+	StreamingPercolation result(width);
+
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+	{
+		throw mabz::FileError("Could not open \"" + path + "\" for reading.");
+	}
+
+	const std::size_t rowBytes = (static_cast<std::size_t>(width) + 7) / 8;
+	std::vector<unsigned char> bits(rowBytes);
+	while (true)
+	{
+		in.read(reinterpret_cast<char*>(bits.data()), rowBytes);
+		const std::size_t got = static_cast<std::size_t>(in.gcount());
+		if (got == 0) break;
+		if (got != rowBytes)
+		{
+			std::stringstream err;
+			err << "Grid file \"" << path << "\" ends part way through row " << result.Rows()
+				<< ": expected rows of " << rowBytes << " bytes for width " << width << ".";
+			throw mabz::FileError(err.str());
+		}
+		result.AddPackedRow(bits.data());
+	}
+	if (in.bad())
+	{
+		throw mabz::FileError("Error reading \"" + path + "\".");
+	}
+
+	result.Finish();
+	return result;
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include "algo_lib/exceptions.h"
+#include "algo_lib/parallel.h"
+#include "algo_lib/tiled_percolation.h"
+#include "algo_lib/union_find.h"
+
+namespace mabz { namespace percolation {
+
+namespace {
+
+const unsigned char kTop{1};
+const unsigned char kBottom{2};
+
+// What one strip's local labelling found: strip cells are labelled
+// 0..mSizes.size()-1 in mLabels, with these sizes and top/bottom flags.
+struct StripClusters
+{
+	int mBeginRow{0};
+	int mEndRow{0};
+	std::vector<long long> mSizes;
+	std::vector<unsigned char> mTouches;
+};
+
+} /* anon namespace */
+
+TiledPercolation::TiledPercolation(const mabz::BitGrid& grid, int threadCount)
+	: mRows(grid.Rows())
+	, mCols(grid.Cols())
+{
+	if (mRows <= 0 || mCols <= 0)
+	{
+		std::stringstream err;
+		err << "Must construct TiledPercolation with a non-empty grid. Instead got "
+		    << mRows << " rows and " << mCols << " cols";
+		throw mabz::IllegalArgumentException(err.str());
+	}
+
+	const int rows{mRows};
+	const int cols{mCols};
+	mLabels.assign(static_cast<std::size_t>(rows) * cols, -1);
+
+	const int stripCount = std::min(mabz::ResolveThreadCount(threadCount), rows);
+	std::vector<StripClusters> strips(stripCount);
+
+	// 1. label each strip on its own.
+	mabz::ParallelFor(stripCount, stripCount, [&](int, std::size_t stripIndex, std::size_t) {
+		StripClusters& strip = strips[stripIndex];
+		strip.mBeginRow = static_cast<int>(static_cast<long long>(rows) * stripIndex / stripCount);
+		strip.mEndRow = static_cast<int>(static_cast<long long>(rows) * (stripIndex + 1) / stripCount);
+		const int stripRows{strip.mEndRow - strip.mBeginRow};
+		const std::size_t firstCell = static_cast<std::size_t>(strip.mBeginRow) * cols;
+
+		mabz::UnionFind<> local(stripRows * cols);
+		for (int r = 0; r < stripRows; r++)
+		{
+			for (int c = 0; c < cols; c++)
+			{
+				if (!grid.Get(strip.mBeginRow + r, c)) continue;
+				const int i{r * cols + c};
+				if (c > 0 && grid.Get(strip.mBeginRow + r, c-1)) local.Union(i, i-1);
+				if (r > 0 && grid.Get(strip.mBeginRow + r - 1, c)) local.Union(i, i-cols);
+			}
+		}
+
+		// number the local roots 0..k-1 in order of first cell.
+		std::vector<int> ids(stripRows * cols, -1);
+		for (int r = 0; r < stripRows; r++)
+		{
+			const int gridRow{strip.mBeginRow + r};
+			const unsigned char touches = (gridRow == 0 ? kTop : 0) | (gridRow == rows-1 ? kBottom : 0);
+			for (int c = 0; c < cols; c++)
+			{
+				if (!grid.Get(gridRow, c)) continue;
+				const int root{local.Find(r * cols + c)};
+				if (ids[root] < 0)
+				{
+					ids[root] = static_cast<int>(strip.mSizes.size());
+					strip.mSizes.push_back(0);
+					strip.mTouches.push_back(0);
+				}
+				const int id{ids[root]};
+				strip.mSizes[id]++;
+				strip.mTouches[id] |= touches;
+				mLabels[firstCell + r * cols + c] = id;
+			}
+		}
+	});
+
+	// 2. stitch strip clusters together across the strip boundaries.
+	std::vector<int> offsets(stripCount + 1, 0);
+	for (int s = 0; s < stripCount; s++)
+	{
+		offsets[s+1] = offsets[s] + static_cast<int>(strips[s].mSizes.size());
+	}
+
+	mabz::UnionFind<> stitched(offsets[stripCount]);
+	for (int s = 0; s + 1 < stripCount; s++)
+	{
+		const std::size_t above = static_cast<std::size_t>(strips[s].mEndRow - 1) * cols;
+		const std::size_t below = above + cols;
+		for (int c = 0; c < cols; c++)
+		{
+			const int labelAbove{mLabels[above + c]};
+			const int labelBelow{mLabels[below + c]};
+			if (labelAbove >= 0 && labelBelow >= 0)
+			{
+				stitched.Union(offsets[s] + labelAbove, offsets[s+1] + labelBelow);
+			}
+		}
+	}
+
+	// final cluster numbers, again in order of first cell.
+	std::vector<int> finalIds(offsets[stripCount], -1);
+	for (int s = 0; s < stripCount; s++)
+	{
+		for (int id = 0; id < static_cast<int>(strips[s].mSizes.size()); id++)
+		{
+			const int global{offsets[s] + id};
+			const int root{stitched.Find(global)};
+			if (finalIds[root] < 0)
+			{
+				finalIds[root] = static_cast<int>(mClusterSizes.size());
+				mClusterSizes.push_back(0);
+				mTouchesTop.push_back(0);
+			}
+			const int label{finalIds[root]};
+			finalIds[global] = label;
+			mClusterSizes[label] += strips[s].mSizes[id];
+			mTouchesTop[label] |= strips[s].mTouches[id];
+		}
+	}
+
+	for (std::size_t label = 0; label < mClusterSizes.size(); label++)
+	{
+		mOpenSites += mClusterSizes[label];
+		mLargestClusterSize = std::max(mLargestClusterSize, mClusterSizes[label]);
+		if (mTouchesTop[label] == (kTop | kBottom)) mPercolates = true;
+		mTouchesTop[label] &= kTop;
+	}
+
+	// 3. rewrite the strip-local labels as final ones.
+	mabz::ParallelFor(stripCount, stripCount, [&](int, std::size_t stripIndex, std::size_t) {
+		const StripClusters& strip = strips[stripIndex];
+		const int offset{offsets[stripIndex]};
+		const std::size_t begin = static_cast<std::size_t>(strip.mBeginRow) * cols;
+		const std::size_t end = static_cast<std::size_t>(strip.mEndRow) * cols;
+		for (std::size_t i = begin; i < end; i++)
+		{
+			if (mLabels[i] >= 0) mLabels[i] = finalIds[offset + mLabels[i]];
+		}
+	});
+}
+
+void TiledPercolation::CheckRowColBounds(int row, int col) const
+{
+	if (row < 1 || row > mRows)
+	{
+		std::stringstream err;
+		err << "Row index must be between 1 and " << mRows << " inclusive. Got " << row;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+	if (col < 1 || col > mCols)
+	{
+		std::stringstream err;
+		err << "Col index must be between 1 and " << mCols << " inclusive. Got " << col;
+		throw mabz::IllegalArgumentException(err.str());
+	}
+}
+
+int TiledPercolation::LabelAt(int row, int col) const
+{
+	return mLabels[static_cast<std::size_t>(row-1) * mCols + (col-1)];
+}
+
+bool TiledPercolation::IsOpen(int row, int col) const
+{
+	CheckRowColBounds(row, col);
+	return LabelAt(row, col) >= 0;
+}
+
+bool TiledPercolation::IsFull(int row, int col) const
+{
+	CheckRowColBounds(row, col);
+	const int label{LabelAt(row, col)};
+	return label >= 0 && mTouchesTop[label];
+}
+
+int TiledPercolation::GetClusterLabel(int row, int col) const
+{
+	CheckRowColBounds(row, col);
+	return LabelAt(row, col);
+}
+
+long long TiledPercolation::GetClusterSize(int row, int col) const
+{
+	CheckRowColBounds(row, col);
+	const int label{LabelAt(row, col)};
+	return label >= 0 ? mClusterSizes[label] : 0;
+}
+
+bool TiledPercolation::Connected(int row1, int col1, int row2, int col2) const
+{
+	CheckRowColBounds(row1, col1);
+	CheckRowColBounds(row2, col2);
+	const int label{LabelAt(row1, col1)};
+	return label >= 0 && label == LabelAt(row2, col2);
+}
+
+} /* namespace percolation */
+} /* namespace mabz */
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <algo_lib/bit_grid.h>
+
+namespace {
+
+TEST(BitGridTest, TestSetAndCount)
+{
+	mabz::BitGrid grid(3, 130);
+	EXPECT_EQ(grid.Count(), 0);
+	EXPECT_EQ(grid.MemoryUsage(), 3 * 3 * sizeof(std::uint64_t));
+
+	EXPECT_TRUE(grid.Set(0, 0));
+	EXPECT_FALSE(grid.Set(0, 0));
+	EXPECT_TRUE(grid.Set(0, 129));
+	EXPECT_TRUE(grid.Set(2, 63));
+	EXPECT_TRUE(grid.Set(2, 64));
+	EXPECT_EQ(grid.Count(), 4);
+
+	EXPECT_TRUE(grid.Get(0, 129));
+	EXPECT_FALSE(grid.Get(1, 129));
+	EXPECT_FALSE(grid.Get(0, 128));
+	EXPECT_EQ(grid.CountInRow(0), 2);
+	EXPECT_EQ(grid.CountInRow(1), 0);
+	EXPECT_EQ(grid.CountInRow(2), 2);
+	EXPECT_TRUE(grid.AnyInRow(2));
+	EXPECT_FALSE(grid.AnyInRow(1));
+
+	grid.ClearAll();
+	EXPECT_EQ(grid.Count(), 0);
+	EXPECT_FALSE(grid.AnyInRow(0));
+}
+
+TEST(BitGridTest, TestPopCount)
+{
+	EXPECT_EQ(mabz::PopCount64(0), 0);
+	EXPECT_EQ(mabz::PopCount64(~std::uint64_t{0}), 64);
+	EXPECT_EQ(mabz::PopCount64(0x8000000000000001ull), 2);
+	EXPECT_EQ(mabz::PopCount64(0xF0F0ull), 8);
+}
+
+} /* anon namespace */
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <algo_lib/bond_percolation.h>
+#include <algo_lib/exceptions.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+using Dir = nsperc::BondDirection;
+
+TEST(BondPercolationTest, TestConstructorThrows)
+{
+	ASSERT_THROW(nsperc::BondPercolation(0), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::BondPercolation(40000), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::BondPercolationStats(1, 10), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::BondPercolationStats(5, 0), mabz::IllegalArgumentException);
+}
+
+TEST(BondPercolationTest, TestMethodsThrow)
+{
+	nsperc::BondPercolation p(4);
+	ASSERT_THROW(p.OpenBond(0, 1, Dir::Right), mabz::IllegalArgumentException);
+	ASSERT_THROW(p.OpenBond(1, 5, Dir::Down), mabz::IllegalArgumentException);
+	// off the right and bottom edges.
+	ASSERT_THROW(p.OpenBond(2, 4, Dir::Right), mabz::IllegalArgumentException);
+	ASSERT_THROW(p.IsBondOpen(4, 2, Dir::Down), mabz::IllegalArgumentException);
+	ASSERT_THROW(p.IsFull(5, 1), mabz::IllegalArgumentException);
+	ASSERT_NO_THROW(p.OpenBond(4, 3, Dir::Right));
+	ASSERT_NO_THROW(p.OpenBond(3, 4, Dir::Down));
+}
+
+TEST(BondPercolationTest, TestPercolatesThroughBonds)
+{
+	const int n{4};
+	nsperc::BondPercolation p(n);
+	EXPECT_EQ(p.BondCount(), 24);
+	EXPECT_FALSE(p.DoesPercolate());
+	// top row sites are always full, everything else starts cut off.
+	EXPECT_TRUE(p.IsFull(1, 3));
+	EXPECT_FALSE(p.IsFull(2, 3));
+
+	// down from (1,1) to (3,1), across to (3,2), down to the bottom.
+	p.OpenBond(1, 1, Dir::Down);
+	p.OpenBond(2, 1, Dir::Down);
+	EXPECT_TRUE(p.IsFull(3, 1));
+	p.OpenBond(3, 1, Dir::Right);
+	EXPECT_TRUE(p.IsFull(3, 2));
+	EXPECT_FALSE(p.DoesPercolate());
+	p.OpenBond(3, 2, Dir::Down);
+	EXPECT_TRUE(p.DoesPercolate());
+
+	// opening twice doesn't count twice.
+	p.OpenBond(3, 2, Dir::Down);
+	EXPECT_EQ(p.GetNumberOfOpenBonds(), 4);
+	EXPECT_TRUE(p.IsBondOpen(3, 1, Dir::Right));
+	EXPECT_FALSE(p.IsBondOpen(3, 1, Dir::Down));
+
+	// bonds within the top row alone never percolate.
+	p.ResetGrid();
+	for (int col = 1; col < n; col++) p.OpenBond(1, col, Dir::Right);
+	EXPECT_FALSE(p.DoesPercolate());
+	EXPECT_EQ(p.GetNumberOfOpenBonds(), n-1);
+}
+
+TEST(BondPercolationTest, TestStats)
+{
+	// the square lattice bond threshold is exactly 1/2; loose bounds for a
+	// small grid.
+	nsperc::BondPercolationStats stats(30, 100);
+	EXPECT_NEAR(stats.Mean(), 0.5, 0.05);
+	EXPECT_GT(stats.Stdev(), 0);
+	EXPECT_LT(stats.ConfidenceLow(), stats.Mean());
+	EXPECT_GT(stats.ConfidenceHigh(), stats.Mean());
+}
+
+} /* anon namespace */
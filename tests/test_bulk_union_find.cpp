@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/bulk_union_find.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+std::vector<std::pair<int,int> > RandomEdges(int n, int count)
+{
+	std::mt19937 randEng(777);
+	std::uniform_int_distribution<int> dist(0, n-1);
+	std::vector<std::pair<int,int> > edges;
+	for (int i = 0; i < count; i++)
+	{
+		edges.emplace_back(dist(randEng), dist(randEng));
+	}
+	return edges;
+}
+
+TEST(BulkUnionFindTest, TestMatchesSequential)
+{
+	const int n{50000};
+	const auto edges = RandomEdges(n, 40000);
+
+	mabz::UnionFind<> expected(n);
+	for (const auto& e : edges) expected.Union(e.first, e.second);
+
+	for (int threads : {1, 3, 8})
+	{
+		mabz::UnionFind<> built = mabz::BuildUnionFind(n, edges, threads);
+		ASSERT_EQ(built.ComponentCount(), expected.ComponentCount());
+		ASSERT_EQ(built.LargestComponentSize(), expected.LargestComponentSize());
+		for (int i = 0; i < n; i++)
+		{
+			const int other = (i * 7919) % n;
+			ASSERT_EQ(built.Connected(i, other), expected.Connected(i, other));
+			ASSERT_EQ(built.ComponentSize(i), expected.ComponentSize(i));
+		}
+
+		// ready for further use like any other UnionFind.
+		built.Union(0, n-1);
+		EXPECT_TRUE(built.Connected(n-1, 0));
+	}
+}
+
+TEST(BulkUnionFindTest, TestOtherPolicies)
+{
+	const int n{300};
+	const auto edges = RandomEdges(n, 200);
+	mabz::UnionFind<> expected(n);
+	for (const auto& e : edges) expected.Union(e.first, e.second);
+
+	auto rank = mabz::BuildUnionFind<mabz::uf_policy::UnionByRank>(n, edges, 4);
+	auto quickFind = mabz::BuildUnionFind<mabz::uf_policy::QuickFind>(n, edges, 4);
+	for (int i = 0; i < n; i++)
+	{
+		ASSERT_EQ(rank.Connected(i, (i * 3) % n), expected.Connected(i, (i * 3) % n));
+		ASSERT_EQ(quickFind.Connected(i, (i * 3) % n), expected.Connected(i, (i * 3) % n));
+	}
+	quickFind.Union(1, 2);
+	EXPECT_TRUE(quickFind.Connected(2, 1));
+}
+
+TEST(BulkUnionFindTest, TestFromFile)
+{
+	const int n{10000};
+	const auto edges = RandomEdges(n, 8000);
+	const std::string path = ::testing::TempDir() + "algo_lib_edges.bin";
+	{
+		std::ofstream out(path, std::ios::binary);
+		for (const auto& e : edges)
+		{
+			const std::int32_t ends[2] = {e.first, e.second};
+			out.write(reinterpret_cast<const char*>(ends), sizeof(ends));
+		}
+	}
+
+	mabz::UnionFind<> expected(n);
+	for (const auto& e : edges) expected.Union(e.first, e.second);
+
+	auto built = mabz::BuildUnionFindFromFile(n, path, 4);
+	ASSERT_EQ(built.ComponentCount(), expected.ComponentCount());
+	for (int i = 0; i < n; i++)
+	{
+		ASSERT_EQ(built.Connected(i, (i * 13) % n), expected.Connected(i, (i * 13) % n));
+	}
+
+	// a site beyond capacity in the file.
+	ASSERT_THROW(mabz::BuildUnionFindFromFile(n / 2, path, 4), mabz::IndexOutOfRange);
+	std::remove(path.c_str());
+}
+
+TEST(BulkUnionFindTest, TestThrows)
+{
+	std::vector<std::pair<int,int> > edges{{0, 1}, {1, 2}, {2, 5}};
+	ASSERT_THROW(mabz::BuildUnionFind(5, edges, 2), mabz::IndexOutOfRange);
+	ASSERT_THROW(mabz::BuildUnionFind(-1, edges, 2), mabz::IllegalArgumentException);
+
+	// roots that aren't roots.
+	ASSERT_THROW(mabz::UnionFind<>::FromRoots(std::vector<int>{1, 2, 2}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::UnionFind<>::FromRoots(std::vector<int>{0, 3}), mabz::IllegalArgumentException);
+
+	auto empty = mabz::BuildUnionFind(0, std::vector<std::pair<int,int> >{}, 2);
+	EXPECT_EQ(empty.ComponentCount(), 0);
+
+	// no sites at all, with the histogram on: its only element is size 0.
+	auto emptyWithHistogram = mabz::UnionFind<>::FromRoots(std::vector<int>{}, true);
+	EXPECT_EQ(emptyWithHistogram.ComponentCount(), 0);
+	EXPECT_EQ(emptyWithHistogram.LargestComponentSize(), 0);
+	EXPECT_EQ(emptyWithHistogram.SizeHistogram(), std::vector<int>{0});
+}
+
+} /* anon namespace */
@@ -0,0 +1,89 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/cell_index.h>
+#include <algo_lib/exceptions.h>
+
+namespace {
+
+namespace layout = mabz::percolation::cell_index;
+
+// every cell of the n-by-n grid gets its own slot in [0, Size()).
+template <typename CellIndex>
+void ExpectOneToOne(int n)
+{
+	CellIndex index(n);
+	ASSERT_GE(index.Size(), n*n);
+	std::vector<bool> used(index.Size(), false);
+	for (int r = 0; r < n; r++)
+	{
+		for (int c = 0; c < n; c++)
+		{
+			const long long slot{index.Index(r, c)};
+			ASSERT_GE(slot, 0);
+			ASSERT_LT(slot, index.Size());
+			ASSERT_FALSE(used[slot]) << r << "," << c;
+			used[slot] = true;
+		}
+	}
+}
+
+TEST(CellIndexTest, TestOneToOne)
+{
+	for (int n : {1, 2, 7, 16, 33, 64})
+	{
+		ExpectOneToOne<layout::RowMajor>(n);
+		ExpectOneToOne<layout::Morton>(n);
+		ExpectOneToOne<layout::BlockedTiles<> >(n);
+		ExpectOneToOne<layout::BlockedTiles<4> >(n);
+	}
+}
+
+TEST(CellIndexTest, TestLayouts)
+{
+	EXPECT_EQ(layout::RowMajor(5).Index(2, 3), 13);
+
+	layout::Morton morton(5);
+	EXPECT_EQ(morton.Size(), 64);
+	EXPECT_EQ(morton.Index(0, 1), 1);
+	EXPECT_EQ(morton.Index(1, 0), 2);
+	EXPECT_EQ(morton.Index(1, 1), 3);
+	EXPECT_EQ(morton.Index(0, 2), 4);
+	EXPECT_EQ(morton.Index(4, 4), 48);
+
+	layout::BlockedTiles<4> tiles(6);
+	EXPECT_EQ(tiles.Size(), 64);
+	EXPECT_EQ(tiles.Index(1, 2), 6);
+	EXPECT_EQ(tiles.Index(0, 4), 16);
+	EXPECT_EQ(tiles.Index(5, 5), 53);
+}
+
+TEST(CellIndexTest, TestThrows)
+{
+	ASSERT_THROW(layout::RowMajor(0), mabz::IllegalArgumentException);
+	ASSERT_THROW(layout::Morton(-1), mabz::IllegalArgumentException);
+	ASSERT_THROW(layout::BlockedTiles<>(0), mabz::IllegalArgumentException);
+}
+
+TEST(CellIndexTest, TestPast32Bits)
+{
+	const int n{100000};
+	layout::RowMajor rowMajor(n);
+	EXPECT_EQ(rowMajor.Size(), 10000000000LL);
+	EXPECT_EQ(rowMajor.Index(n-1, n-1), 9999999999LL);
+
+	layout::Morton morton(n);
+	EXPECT_EQ(morton.Size(), 131072LL * 131072LL);
+	// col on the even bits, row on the odd ones.
+	EXPECT_EQ(morton.Index(0, 65536), 1LL << 32);
+	EXPECT_EQ(morton.Index(65536, 0), 1LL << 33);
+	EXPECT_EQ(morton.Index(n-1, n-1), morton.Index(n-1, 0) + morton.Index(0, n-1));
+	EXPECT_LT(morton.Index(n-1, n-1), morton.Size());
+
+	layout::BlockedTiles<> tiles(n);
+	EXPECT_EQ(tiles.Size(), 100000LL * 100000LL);
+	EXPECT_EQ(tiles.Index(n-1, n-1), tiles.Size() - 1);
+}
+
+} /* anon namespace */
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <exception>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/compact_union_find.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+template <typename Index>
+class CompactUnionFindTest : public ::testing::Test {};
+
+using IndexTypes = ::testing::Types<std::uint16_t, std::uint32_t, std::uint64_t, int>;
+TYPED_TEST_SUITE(CompactUnionFindTest, IndexTypes);
+
+TYPED_TEST(CompactUnionFindTest, TestMatchesUnionFind)
+{
+	const int n{1000};
+	mabz::CompactUnionFind<TypeParam> compact(n);
+	mabz::UnionFind<> expected(n);
+
+	for (int i = 0; i < 700; i++)
+	{
+		const int a = (i * 31) % n;
+		const int b = (i * 57 + 3) % n;
+		compact.Union(static_cast<TypeParam>(a), static_cast<TypeParam>(b));
+		expected.Union(a, b);
+	}
+
+	int largest{0};
+	for (int i = 0; i < n; i++)
+	{
+		const int other = (i * 17) % n;
+		ASSERT_EQ(compact.Connected(static_cast<TypeParam>(i), static_cast<TypeParam>(other)),
+			expected.Connected(i, other));
+		const int size = static_cast<int>(compact.ComponentSize(static_cast<TypeParam>(i)));
+		largest = size > largest ? size : largest;
+	}
+	EXPECT_GT(largest, 1);
+
+	EXPECT_EQ(compact.MemoryUsage(), n * sizeof(TypeParam));
+
+	compact.Reset();
+	EXPECT_FALSE(compact.Connected(0, 31));
+	EXPECT_EQ(compact.ComponentSize(0), 1u);
+}
+
+TEST(CompactUnionFindTest, TestComponentSizes)
+{
+	mabz::CompactUnionFind<std::uint16_t> uf(6);
+	uf.Union(0, 1);
+	uf.Union(2, 3);
+	uf.Union(3, 4);
+	EXPECT_EQ(uf.ComponentSize(0), 2);
+	EXPECT_EQ(uf.ComponentSize(4), 3);
+	EXPECT_EQ(uf.ComponentSize(5), 1);
+	EXPECT_EQ(uf.Find(2), uf.Find(4));
+
+	uf.Union(1, 4);
+	EXPECT_EQ(uf.ComponentSize(2), 5);
+	EXPECT_TRUE(uf.Connected(0, 3));
+	EXPECT_FALSE(uf.Connected(0, 5));
+}
+
+TEST(CompactUnionFindTest, TestThrows)
+{
+	mabz::CompactUnionFind<std::uint32_t> uf(3);
+	ASSERT_THROW(uf.Connected(1, 3), mabz::IndexOutOfRange);
+	ASSERT_THROW(uf.Union(7, 0), mabz::IndexOutOfRange);
+
+	mabz::CompactUnionFind<int> signedUf(3);
+	ASSERT_THROW(signedUf.Connected(-1, 0), mabz::IndexOutOfRange);
+
+	// one bit goes on the root flag, so 16 bit indices stop at 32767 sites.
+	ASSERT_THROW(mabz::CompactUnionFind<std::uint16_t> uf16(40000), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CompactUnionFind<int> negative(-1), mabz::IllegalArgumentException);
+}
+
+} /* anon namespace */
@@ -0,0 +1,90 @@
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/concurrent_union_find.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+TEST(ConcurrentUnionFindTest, TestSingleThreaded)
+{
+	mabz::ConcurrentUnionFind uf(9);
+	uf.Union(1, 2);
+	uf.Union(3, 4);
+	uf.Union(3, 5);
+	uf.Union(6, 7);
+	uf.Union(7, 8);
+
+	EXPECT_TRUE(uf.Connected(1, 2));
+	EXPECT_TRUE(uf.Connected(4, 5));
+	EXPECT_TRUE(uf.Connected(6, 8));
+	EXPECT_FALSE(uf.Connected(1, 3));
+	EXPECT_FALSE(uf.Connected(5, 6));
+	EXPECT_EQ(uf.Find(6), uf.Find(8));
+
+	ASSERT_THROW(uf.Union(0, 9), mabz::IndexOutOfRange);
+	ASSERT_THROW(uf.Connected(-1, 0), mabz::IndexOutOfRange);
+
+	uf.Reset();
+	EXPECT_FALSE(uf.Connected(1, 2));
+}
+
+TEST(ConcurrentUnionFindTest, TestStressAgainstSequential)
+{
+	const int n{20000};
+	const int edgeCount{15000};
+	const int threadCount{8};
+
+	std::mt19937 randEng(12345);
+	std::uniform_int_distribution<int> dist(0, n-1);
+	std::vector<std::pair<int,int> > edges;
+	for (int i = 0; i < edgeCount; i++)
+	{
+		edges.emplace_back(dist(randEng), dist(randEng));
+	}
+
+	mabz::UnionFind<> expected(n);
+	for (const auto& e : edges)
+	{
+		expected.Union(e.first, e.second);
+	}
+
+	for (int round = 0; round < 5; round++)
+	{
+		mabz::ConcurrentUnionFind uf(n);
+
+		// every thread takes an interleaved share of the edges, and hammers
+		// Connected on the same sites in between so finds race with links.
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&, t]() {
+				for (int i = t; i < edgeCount; i += threadCount)
+				{
+					uf.Union(edges[i].first, edges[i].second);
+					// anything unioned by this thread must be visible to it straight away.
+					if (!uf.Connected(edges[i].second, edges[i].first))
+					{
+						ADD_FAILURE() << "Union not visible to the thread that made it.";
+					}
+					uf.Connected(edges[(i * 7) % edgeCount].first, edges[i].second);
+				}
+			});
+		}
+		for (auto& th : threads) th.join();
+
+		for (int i = 0; i < n; i++)
+		{
+			const int other = (i * 7919) % n;
+			ASSERT_EQ(uf.Connected(i, other), expected.Connected(i, other)) << i << " " << other;
+			ASSERT_EQ(uf.Connected(i, edges[i % edgeCount].first), expected.Connected(i, edges[i % edgeCount].first));
+		}
+	}
+}
+
+} /* anon namespace */
@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/csr_graph.h>
+#include <algo_lib/exceptions.h>
+
+namespace {
+
+std::string TempPath(const std::string& name)
+{
+	return ::testing::TempDir() + "algo_lib_" + name;
+}
+
+std::vector<int> NeighboursOf(const mabz::CsrGraph& graph, int v)
+{
+	return std::vector<int>(graph.NeighboursBegin(v), graph.NeighboursEnd(v));
+}
+
+TEST(CsrGraphTest, TestFromEdges)
+{
+	// a triangle 0-1-2, a pendant 3 off 2, an isolated 4 and a self loop on 1.
+	const auto graph = mabz::CsrGraph::FromEdges(5, {{0, 1}, {1, 2}, {2, 0}, {3, 2}, {1, 1}});
+	EXPECT_EQ(graph.VertexCount(), 5);
+	EXPECT_EQ(graph.AdjacencyCount(), 9u);
+	EXPECT_EQ(NeighboursOf(graph, 0), (std::vector<int>{1, 2}));
+	EXPECT_EQ(NeighboursOf(graph, 1), (std::vector<int>{0, 2, 1}));
+	EXPECT_EQ(NeighboursOf(graph, 2), (std::vector<int>{1, 0, 3}));
+	EXPECT_EQ(NeighboursOf(graph, 3), (std::vector<int>{2}));
+	EXPECT_EQ(graph.Degree(4), 0);
+
+	ASSERT_THROW(mabz::CsrGraph::FromEdges(3, {{0, 3}}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CsrGraph::FromEdges(-1, {}), mabz::IllegalArgumentException);
+	EXPECT_EQ(mabz::CsrGraph().VertexCount(), 0);
+}
+
+TEST(CsrGraphTest, TestValidation)
+{
+	ASSERT_NO_THROW(mabz::CsrGraph({0, 1, 2}, {1, 0}));
+	ASSERT_THROW(mabz::CsrGraph({}, {}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CsrGraph({1, 2}, {0, 0}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CsrGraph({0, 1, 3}, {1, 0}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CsrGraph({0, 2, 1, 2}, {1, 0}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CsrGraph({0, 1, 2}, {1, 2}), mabz::IllegalArgumentException);
+	ASSERT_THROW(mabz::CsrGraph({0, 1, 2}, {-1, 0}), mabz::IllegalArgumentException);
+}
+
+TEST(CsrGraphTest, TestSaveAndLoad)
+{
+	std::vector<std::pair<int,int> > edges;
+	for (int v = 0; v + 1 < 1000; v++) edges.emplace_back(v, (v * 7 + 3) % 1000);
+	const auto graph = mabz::CsrGraph::FromEdges(1000, edges);
+
+	const std::string path = TempPath("graph.csr");
+	graph.Save(path);
+	const auto loaded = mabz::CsrGraph::Load(path);
+	EXPECT_EQ(loaded.Offsets(), graph.Offsets());
+	EXPECT_EQ(loaded.Neighbours(), graph.Neighbours());
+
+	// chop the last neighbour off.
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		in.close();
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), bytes.size() - sizeof(std::int32_t));
+	}
+	ASSERT_THROW(mabz::CsrGraph::Load(path), mabz::FileError);
+	std::remove(path.c_str());
+
+	ASSERT_THROW(mabz::CsrGraph::Load(TempPath("no_such_graph.csr")), mabz::FileError);
+}
+
+TEST(CsrGraphTest, TestLoadRejectsBadContents)
+{
+	const std::string path = TempPath("bad_graph.csr");
+	{
+		std::ofstream out(path, std::ios::binary);
+		out << "definitely not a graph file, but long enough for a header";
+	}
+	ASSERT_THROW(mabz::CsrGraph::Load(path), mabz::FileError);
+
+	// right shape, but a neighbour that isn't a vertex.
+	mabz::CsrGraph({0, 1, 2}, {1, 0}).Save(path);
+	{
+		std::fstream patch(path, std::ios::binary | std::ios::in | std::ios::out);
+		patch.seekp(sizeof(mabz::CsrGraphFileHeader) + 3 * sizeof(std::uint64_t));
+		const std::int32_t bad{7};
+		patch.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+	}
+	ASSERT_THROW(mabz::CsrGraph::Load(path), mabz::FileError);
+	std::remove(path.c_str());
+}
+
+} /* anon namespace */
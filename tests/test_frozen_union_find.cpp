@@ -0,0 +1,93 @@
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/frozen_union_find.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+TEST(FrozenUnionFindTest, TestFreeze)
+{
+	mabz::UnionFind<> uf(9);
+	uf.Union(1, 2);
+	uf.Union(3, 4);
+	uf.Union(3, 5);
+	uf.Union(6, 7);
+	uf.Union(7, 8);
+
+	const mabz::FrozenUnionFind frozen = uf.Freeze();
+	EXPECT_EQ(frozen.Capacity(), 9);
+	EXPECT_EQ(frozen.ComponentCount(), 4);
+	EXPECT_TRUE(frozen.Connected(1, 2));
+	EXPECT_TRUE(frozen.Connected(4, 5));
+	EXPECT_TRUE(frozen.Connected(6, 8));
+	EXPECT_FALSE(frozen.Connected(0, 1));
+	EXPECT_FALSE(frozen.Connected(5, 6));
+	EXPECT_EQ(frozen.Label(3), frozen.Label(5));
+	ASSERT_THROW(frozen.Connected(0, 9), mabz::IndexOutOfRange);
+	ASSERT_THROW(frozen.Label(-1), mabz::IndexOutOfRange);
+
+	// the original carries on independently.
+	uf.Union(0, 8);
+	EXPECT_TRUE(uf.Connected(0, 6));
+	EXPECT_FALSE(frozen.Connected(0, 6));
+}
+
+TEST(FrozenUnionFindTest, TestBatchAndConcurrentQueries)
+{
+	const int n{20000};
+	mabz::UnionFind<mabz::uf_policy::WeightedQuickUnion> uf(n);
+	for (int i = 0; i < 15000; i++) uf.Union((i * 31) % n, (i * 57 + 3) % n);
+	const mabz::FrozenUnionFind frozen = uf.Freeze();
+
+	std::vector<int> a(n);
+	std::vector<int> b(n);
+	std::vector<std::pair<int,int> > pairs(n);
+	for (int i = 0; i < n; i++)
+	{
+		a[i] = i;
+		b[i] = (i * 7919) % n;
+		pairs[i] = std::make_pair(a[i], b[i]);
+	}
+
+	const int threadCount{4};
+	std::vector<std::unique_ptr<bool[]> > results;
+	std::vector<std::unique_ptr<bool[]> > pairResults;
+	for (int t = 0; t < threadCount; t++)
+	{
+		results.emplace_back(new bool[n]);
+		pairResults.emplace_back(new bool[n]);
+	}
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&, t]() {
+			frozen.ConnectedBatch(a.data(), b.data(), n, results[t].get());
+			frozen.ConnectedBatch(pairs.data(), pairs.size(), pairResults[t].get());
+		});
+	}
+	for (auto& th : threads) th.join();
+
+	for (int t = 0; t < threadCount; t++)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			ASSERT_EQ(results[t][i], uf.Connected(a[i], b[i]));
+			ASSERT_EQ(pairResults[t][i], results[t][i]);
+		}
+	}
+
+	b[n/2] = n;
+	ASSERT_THROW(frozen.ConnectedBatch(a.data(), b.data(), n, results[0].get()), mabz::IndexOutOfRange);
+	a[0] = -3;
+	ASSERT_THROW(frozen.ConnectedBatch(a.data(), a.data(), 1, results[0].get()), mabz::IndexOutOfRange);
+}
+
+} /* anon namespace */
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/csr_graph.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/graph_percolation.h>
+#include <algo_lib/percolation.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+
+// n-by-n square lattice with vertex (row-1)*n + (col-1), and its top and
+// bottom rows as sources and sinks.
+nsperc::GraphPercolation GridGraph(int n)
+{
+	std::vector<std::pair<int,int> > edges;
+	std::vector<int> top;
+	std::vector<int> bottom;
+	for (int r = 0; r < n; r++)
+	{
+		for (int c = 0; c < n; c++)
+		{
+			if (c + 1 < n) edges.emplace_back(r*n + c, r*n + c + 1);
+			if (r + 1 < n) edges.emplace_back(r*n + c, (r+1)*n + c);
+		}
+	}
+	for (int c = 0; c < n; c++)
+	{
+		top.push_back(c);
+		bottom.push_back((n-1)*n + c);
+	}
+	return nsperc::GraphPercolation(mabz::CsrGraph::FromEdges(n*n, edges), top, bottom);
+}
+
+TEST(GraphPercolationTest, TestConstructorAndMethodsThrow)
+{
+	auto graph = mabz::CsrGraph::FromEdges(3, {{0, 1}, {1, 2}});
+	ASSERT_THROW(nsperc::GraphPercolation(graph, {3}, {0}), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::GraphPercolation(graph, {0}, {-1}), mabz::IllegalArgumentException);
+
+	nsperc::GraphPercolation p(graph, {0}, {2});
+	ASSERT_THROW(p.Open(3), mabz::IllegalArgumentException);
+	ASSERT_THROW(p.IsOpen(-1), mabz::IllegalArgumentException);
+	ASSERT_THROW(p.IsFull(5), mabz::IllegalArgumentException);
+}
+
+TEST(GraphPercolationTest, TestPath)
+{
+	nsperc::GraphPercolation p(mabz::CsrGraph::FromEdges(4, {{0, 1}, {1, 2}, {2, 3}}), {0}, {3});
+	EXPECT_EQ(p.VertexCount(), 4);
+	p.Open(0);
+	p.Open(3);
+	p.Open(2);
+	EXPECT_FALSE(p.DoesPercolate());
+	EXPECT_TRUE(p.IsFull(0));
+	EXPECT_FALSE(p.IsFull(2));
+	p.Open(1);
+	EXPECT_TRUE(p.DoesPercolate());
+	EXPECT_TRUE(p.IsFull(2));
+	EXPECT_EQ(p.GetNumberOfOpenSites(), 4);
+
+	p.ResetGrid();
+	EXPECT_FALSE(p.DoesPercolate());
+	EXPECT_FALSE(p.IsOpen(1));
+	EXPECT_EQ(p.GetNumberOfOpenSites(), 0);
+}
+
+TEST(GraphPercolationTest, TestSourceThatIsAlsoASink)
+{
+	nsperc::GraphPercolation p(mabz::CsrGraph::FromEdges(2, {}), {0, 1}, {1});
+	p.Open(0);
+	EXPECT_FALSE(p.DoesPercolate());
+	p.Open(1);
+	EXPECT_TRUE(p.DoesPercolate());
+}
+
+TEST(GraphPercolationTest, TestGridGraphMatchesPercolation)
+{
+	const int n{20};
+	nsperc::Percolation grid(n);
+	auto graph = GridGraph(n);
+
+	std::vector<int> order(n * n);
+	for (int v = 0; v < n*n; v++) order[v] = v;
+	std::shuffle(order.begin(), order.end(), std::default_random_engine{});
+	for (int v : order)
+	{
+		grid.Open(1 + v / n, 1 + v % n);
+		graph.Open(v);
+		ASSERT_EQ(graph.DoesPercolate(), grid.DoesPercolate());
+		ASSERT_EQ(graph.IsFull(v), grid.IsFull(1 + v / n, 1 + v % n));
+	}
+}
+
+} /* anon namespace */
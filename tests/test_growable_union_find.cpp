@@ -0,0 +1,98 @@
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/growable_union_find.h>
+
+namespace {
+
+TEST(GrowableUnionFindTest, TestAddSiteAndGrow)
+{
+	mabz::GrowableUnionFind uf;
+	EXPECT_EQ(uf.Size(), 0);
+	EXPECT_EQ(uf.Capacity(), 0);
+
+	// enough sites to span several chunks, linking each new one to an older one.
+	const int n{10000};
+	for (int i = 0; i < n; i++)
+	{
+		ASSERT_EQ(uf.AddSite(), i);
+		if (i >= 3) uf.Union(i, i - 3);
+	}
+	EXPECT_EQ(uf.Size(), n);
+	EXPECT_GE(uf.Capacity(), n);
+	EXPECT_EQ(uf.ComponentCount(), 3);
+	EXPECT_TRUE(uf.Connected(0, n - 1 - ((n - 1) % 3)));
+	EXPECT_FALSE(uf.Connected(0, 1));
+	EXPECT_EQ(uf.ComponentSize(1) + uf.ComponentSize(2) + uf.ComponentSize(0), n);
+
+	ASSERT_THROW(uf.Connected(0, n), mabz::IndexOutOfRange);
+
+	uf.Reset();
+	EXPECT_EQ(uf.Size(), n);
+	EXPECT_EQ(uf.ComponentCount(), n);
+	EXPECT_FALSE(uf.Connected(0, 3));
+}
+
+TEST(GrowableUnionFindTest, TestReserveDoesNotAddSites)
+{
+	mabz::GrowableUnionFind uf(5);
+	uf.Union(1, 4);
+	uf.Reserve(20000);
+	EXPECT_EQ(uf.Size(), 5);
+	EXPECT_GE(uf.Capacity(), 20000);
+	EXPECT_TRUE(uf.Connected(4, 1));
+
+	const int capacity = uf.Capacity();
+	for (int i = 5; i < capacity; i++) uf.AddSite();
+	EXPECT_EQ(uf.Capacity(), capacity);
+
+	ASSERT_THROW(mabz::GrowableUnionFind bad(-1), mabz::IllegalArgumentException);
+}
+
+TEST(GrowableUnionFindTest, TestMove)
+{
+	mabz::GrowableUnionFind uf(4);
+	uf.Union(0, 3);
+
+	mabz::GrowableUnionFind moved(std::move(uf));
+	EXPECT_TRUE(moved.Connected(0, 3));
+	moved.AddSite();
+	moved.Union(4, 3);
+	EXPECT_EQ(moved.ComponentSize(0), 3);
+
+	std::vector<mabz::GrowableUnionFind> many;
+	many.push_back(std::move(moved));
+	EXPECT_TRUE(many[0].Connected(0, 4));
+}
+
+TEST(GrowableUnionFindTest, TestReuseMovedFrom)
+{
+	mabz::GrowableUnionFind uf(5);
+	uf.Union(1, 2);
+	mabz::GrowableUnionFind moved(std::move(uf));
+
+	EXPECT_EQ(uf.Size(), 0);
+	EXPECT_EQ(uf.ComponentCount(), 0);
+	EXPECT_EQ(uf.Capacity(), 0);
+	ASSERT_THROW(uf.Find(0), mabz::IndexOutOfRange);
+	EXPECT_EQ(uf.AddSite(), 0);
+	EXPECT_EQ(uf.AddSite(), 1);
+	uf.Union(0, 1);
+	EXPECT_EQ(uf.ComponentCount(), 1);
+	EXPECT_EQ(uf.ComponentSize(1), 2);
+
+	// and the same through move assignment.
+	mabz::GrowableUnionFind other(3);
+	other = std::move(moved);
+	EXPECT_TRUE(other.Connected(1, 2));
+	EXPECT_EQ(other.Size(), 5);
+	EXPECT_EQ(moved.Size(), 0);
+	EXPECT_EQ(moved.AddSite(), 0);
+	EXPECT_EQ(moved.ComponentCount(), 1);
+}
+
+} /* anon namespace */
@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/invasion_percolation.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+
+TEST(InvasionPercolationTest, TestConstructorThrows)
+{
+	ASSERT_THROW(nsperc::InvasionPercolation(0), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::InvasionPercolationStats(0, 5), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::InvasionPercolationStats(5, 0), mabz::IllegalArgumentException);
+}
+
+TEST(InvasionPercolationTest, TestSingleCell)
+{
+	nsperc::InvasionPercolation invasion(1);
+	const double threshold = invasion.Run(7);
+	EXPECT_GE(threshold, 0);
+	EXPECT_LT(threshold, 1);
+	EXPECT_EQ(invasion.GetNumberOfInvadedSites(), 1);
+	EXPECT_TRUE(invasion.IsInvaded(1, 1));
+	ASSERT_THROW(invasion.IsInvaded(2, 1), mabz::IllegalArgumentException);
+}
+
+TEST(InvasionPercolationTest, TestClusterSpansFromTopToBottom)
+{
+	const int n{50};
+	nsperc::InvasionPercolation invasion(n);
+	for (std::uint64_t seed = 0; seed < 10; seed++)
+	{
+		const double threshold = invasion.Run(seed);
+		EXPECT_EQ(threshold, invasion.Threshold());
+		EXPECT_GT(threshold, 0);
+		EXPECT_LT(threshold, 1);
+
+		// exactly one bottom row cell (the last one invaded), and it's joined to
+		// the top row through invaded cells.
+		int bottomCells{0};
+		for (int col = 1; col <= n; col++) bottomCells += invasion.IsInvaded(n, col) ? 1 : 0;
+		EXPECT_EQ(bottomCells, 1);
+
+		std::vector<std::vector<bool> > reached(n + 2, std::vector<bool>(n + 2, false));
+		std::vector<std::pair<int,int> > stack;
+		for (int col = 1; col <= n; col++)
+		{
+			if (invasion.IsInvaded(1, col))
+			{
+				reached[1][col] = true;
+				stack.emplace_back(1, col);
+			}
+		}
+		long long reachedCount{0};
+		while (!stack.empty())
+		{
+			const auto cell = stack.back();
+			stack.pop_back();
+			reachedCount++;
+			const int dRow[] = {-1, 1, 0, 0};
+			const int dCol[] = {0, 0, -1, 1};
+			for (int k = 0; k < 4; k++)
+			{
+				const int r{cell.first + dRow[k]};
+				const int c{cell.second + dCol[k]};
+				if (r < 1 || r > n || c < 1 || c > n || reached[r][c] || !invasion.IsInvaded(r, c)) continue;
+				reached[r][c] = true;
+				stack.emplace_back(r, c);
+			}
+		}
+		// the invaded cells all hang off the top row.
+		EXPECT_EQ(reachedCount, invasion.GetNumberOfInvadedSites());
+		EXPECT_GT(invasion.GetNumberOfTouchedSites(), invasion.GetNumberOfInvadedSites());
+	}
+}
+
+TEST(InvasionPercolationTest, TestReproducibleAndLocal)
+{
+	const int n{300};
+	nsperc::InvasionPercolation a(n);
+	nsperc::InvasionPercolation b(n);
+	EXPECT_EQ(a.Run(42), b.Run(42));
+	EXPECT_EQ(a.GetNumberOfInvadedSites(), b.GetNumberOfInvadedSites());
+
+	// the invaded cluster is fractal, so a big grid is mostly never touched.
+	EXPECT_LT(a.GetNumberOfTouchedSites(), n * n / 2);
+}
+
+TEST(InvasionPercolationTest, TestStats)
+{
+	nsperc::InvasionPercolationStats stats(100, 40);
+	EXPECT_NEAR(stats.Mean(), 0.5927, 0.05);
+	EXPECT_GT(stats.Stdev(), 0);
+	EXPECT_LT(stats.ConfidenceLow(), stats.Mean());
+	EXPECT_GT(stats.ConfidenceHigh(), stats.Mean());
+}
+
+} /* anon namespace */
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/lattice_percolation.h>
+#include <algo_lib/percolation.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+namespace lattice = mabz::percolation::lattice;
+
+// Opens sites in a random order until the system percolates and returns the
+// fraction that were open.
+template <typename Perc>
+double OpenUntilPercolates(Perc& perc, std::mt19937_64& randEng)
+{
+	std::vector<int> sites(perc.Sites());
+	std::iota(sites.begin(), sites.end(), 0);
+	std::shuffle(sites.begin(), sites.end(), randEng);
+	perc.ResetGrid();
+	for (int site : sites)
+	{
+		perc.Open(perc.SiteCoords(site));
+		if (perc.DoesPercolate()) break;
+	}
+	return static_cast<double>(perc.GetNumberOfOpenSites()) / perc.Sites();
+}
+
+template <typename Perc>
+double MeanThreshold(Perc& perc, int trials)
+{
+	std::mt19937_64 randEng(12345);
+	double total{0};
+	for (int t = 0; t < trials; t++) total += OpenUntilPercolates(perc, randEng);
+	return total / trials;
+}
+
+TEST(LatticePercolationTest, TestOffsets)
+{
+	static_assert(lattice::Square::kNeighbours == 4, "");
+	static_assert(lattice::Cubic::kNeighbours == 6, "");
+	static_assert(lattice::Cubic::kOffsets[4][2] == -1 && lattice::Cubic::kOffsets[5][2] == 1, "");
+	static_assert(lattice::Triangular::kNeighbours == 6, "");
+
+	// every offset's opposite is in there too.
+	for (const auto& offset : lattice::Triangular::kOffsets)
+	{
+		bool found{false};
+		for (const auto& other : lattice::Triangular::kOffsets)
+		{
+			if (other[0] == -offset[0] && other[1] == -offset[1]) found = true;
+		}
+		EXPECT_TRUE(found);
+	}
+}
+
+TEST(LatticePercolationTest, TestConstructorAndBoundsThrow)
+{
+	using Box = nsperc::LatticePercolation<lattice::Cubic>;
+	ASSERT_THROW(Box({0, 3, 3}), mabz::IllegalArgumentException);
+	ASSERT_THROW(Box({3, -1, 3}), mabz::IllegalArgumentException);
+	ASSERT_THROW(Box({2000, 2000, 2000}), mabz::IllegalArgumentException);
+
+	Box box({2, 3, 4});
+	EXPECT_EQ(box.Sites(), 24);
+	ASSERT_THROW(box.Open({0, 1, 1}), mabz::IllegalArgumentException);
+	ASSERT_THROW(box.IsOpen({1, 4, 1}), mabz::IllegalArgumentException);
+	ASSERT_THROW(box.IsFull({1, 1, 5}), mabz::IllegalArgumentException);
+	ASSERT_THROW(box.SiteCoords(24), mabz::IllegalArgumentException);
+	EXPECT_EQ(box.SiteCoords(0), (Box::Coords{1, 1, 1}));
+	EXPECT_EQ(box.SiteCoords(23), (Box::Coords{2, 3, 4}));
+	EXPECT_EQ(box.SiteCoords(13), (Box::Coords{2, 1, 2}));
+}
+
+TEST(LatticePercolationTest, TestSquareMatchesPercolation)
+{
+	const int n{25};
+	nsperc::Percolation grid(n);
+	nsperc::LatticePercolation<lattice::Square> square({n, n});
+
+	std::vector<int> sites(n * n);
+	std::iota(sites.begin(), sites.end(), 0);
+	std::shuffle(sites.begin(), sites.end(), std::mt19937_64(3));
+	for (int site : sites)
+	{
+		const auto coords = square.SiteCoords(site);
+		grid.Open(coords[0], coords[1]);
+		square.Open(coords);
+		ASSERT_EQ(square.DoesPercolate(), grid.DoesPercolate());
+		ASSERT_EQ(square.IsFull(coords), grid.IsFull(coords[0], coords[1]));
+	}
+}
+
+TEST(LatticePercolationTest, TestRectangle)
+{
+	// 2 rows, 5 cols: percolates top to bottom through any column.
+	nsperc::LatticePercolation<lattice::Square> wide({2, 5});
+	wide.Open({1, 5});
+	EXPECT_FALSE(wide.DoesPercolate());
+	wide.Open({2, 5});
+	EXPECT_TRUE(wide.DoesPercolate());
+	EXPECT_EQ(wide.GetNumberOfOpenSites(), 2);
+}
+
+TEST(LatticePercolationTest, TestCubicColumn)
+{
+	nsperc::LatticePercolation<lattice::Cubic> cube({4, 4, 4});
+	for (int depth = 1; depth <= 4; depth++)
+	{
+		EXPECT_FALSE(cube.DoesPercolate());
+		cube.Open({depth, 2, 3});
+	}
+	EXPECT_TRUE(cube.DoesPercolate());
+	EXPECT_TRUE(cube.IsFull({3, 2, 3}));
+	EXPECT_FALSE(cube.IsOpen({3, 3, 3}));
+}
+
+TEST(LatticePercolationTest, TestTriangularDiagonal)
+{
+	// a down-right diagonal is connected on the triangular lattice only.
+	nsperc::LatticePercolation<lattice::Triangular> triangular({3, 3});
+	nsperc::LatticePercolation<lattice::Square> square({3, 3});
+	for (int i = 1; i <= 3; i++)
+	{
+		triangular.Open({i, i});
+		square.Open({i, i});
+	}
+	EXPECT_TRUE(triangular.DoesPercolate());
+	EXPECT_FALSE(square.DoesPercolate());
+
+	// ...but not the other diagonal.
+	nsperc::LatticePercolation<lattice::Triangular> other({3, 3});
+	for (int i = 1; i <= 3; i++) other.Open({i, 4 - i});
+	EXPECT_FALSE(other.DoesPercolate());
+}
+
+TEST(LatticePercolationTest, TestPeriodicWrapsSideways)
+{
+	// down col 1, across the seam to col 4, down col 4.
+	auto openPath = [](auto& perc) {
+		perc.Open({1, 1});
+		perc.Open({2, 1});
+		perc.Open({2, 4});
+		perc.Open({3, 4});
+	};
+	nsperc::LatticePercolation<lattice::Square, true> cylinder({3, 4});
+	nsperc::LatticePercolation<lattice::Square> flat({3, 4});
+	openPath(cylinder);
+	openPath(flat);
+	EXPECT_TRUE(cylinder.DoesPercolate());
+	EXPECT_FALSE(flat.DoesPercolate());
+
+	// the percolating axis itself never wraps.
+	nsperc::LatticePercolation<lattice::Square, true> ends({3, 4});
+	ends.Open({1, 2});
+	ends.Open({3, 2});
+	EXPECT_FALSE(ends.DoesPercolate());
+	EXPECT_FALSE(ends.IsFull({3, 2}));
+}
+
+TEST(LatticePercolationTest, TestThresholds)
+{
+	// loose bounds around the known infinite lattice values; small boxes
+	// and few trials are noisy.
+	nsperc::LatticePercolation<lattice::Square> square({40, 40});
+	EXPECT_NEAR(MeanThreshold(square, 40), 0.5927, 0.04);
+
+	nsperc::LatticePercolation<lattice::Triangular> triangular({40, 40});
+	EXPECT_NEAR(MeanThreshold(triangular, 40), 0.5, 0.04);
+
+	nsperc::LatticePercolation<lattice::Cubic, true> cubic({16, 16, 16});
+	EXPECT_NEAR(MeanThreshold(cubic, 20), 0.3116, 0.04);
+}
+
+} /* anon namespace */
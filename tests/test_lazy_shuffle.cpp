@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/lazy_shuffle.h>
+
+namespace {
+
+TEST(LazyShuffleTest, TestConstructorThrows)
+{
+	ASSERT_THROW(mabz::LazyShuffle(-1), mabz::IllegalArgumentException);
+}
+
+TEST(LazyShuffleTest, TestHandsOutAPermutation)
+{
+	const int size{1000};
+	mabz::LazyShuffle shuffle(size);
+	std::mt19937_64 randEng(3);
+	std::vector<int> seen;
+	while (shuffle.Remaining() > 0) seen.push_back(shuffle.Next(randEng));
+	ASSERT_THROW(shuffle.Next(randEng), mabz::UnexpectedMethodCall);
+
+	ASSERT_EQ(static_cast<int>(seen.size()), size);
+	std::vector<int> sorted(seen);
+	std::sort(sorted.begin(), sorted.end());
+	for (int i = 0; i < size; i++) ASSERT_EQ(sorted[i], i);
+
+	// shuffled, not handed out in order.
+	int inPlace{0};
+	for (int i = 0; i < size; i++) inPlace += seen[i] == i ? 1 : 0;
+	EXPECT_LT(inPlace, 10);
+}
+
+TEST(LazyShuffleTest, TestRewindReplaysFromAnyPoint)
+{
+	mabz::LazyShuffle shuffle(500);
+	std::vector<int> first;
+	std::mt19937_64 randEng(11);
+	for (int i = 0; i < 200; i++) first.push_back(shuffle.Next(randEng));
+
+	// a partial run, then a rewind, leaves no trace: the same engine state
+	// gives the same values.
+	for (int stopAfter : {0, 1, 37, 200, 500})
+	{
+		shuffle.Rewind();
+		std::mt19937_64 other(99);
+		for (int i = 0; i < stopAfter; i++) shuffle.Next(other);
+
+		shuffle.Rewind();
+		EXPECT_EQ(shuffle.Remaining(), 500);
+		std::mt19937_64 replay(11);
+		for (int i = 0; i < 200; i++) ASSERT_EQ(shuffle.Next(replay), first[i]) << stopAfter;
+	}
+}
+
+TEST(LazyShuffleTest, TestRoughlyUniform)
+{
+	// every value should come first about equally often.
+	const int size{5};
+	const int runs{50000};
+	std::vector<int> firstCounts(size, 0);
+	mabz::LazyShuffle shuffle(size);
+	std::mt19937_64 randEng(5);
+	for (int run = 0; run < runs; run++)
+	{
+		shuffle.Rewind();
+		firstCounts[shuffle.Next(randEng)]++;
+		shuffle.Next(randEng);
+	}
+	for (int count : firstCounts) EXPECT_NEAR(count, runs / size, runs / size / 10);
+}
+
+TEST(LazyShuffleTest, TestWideValuesGiveTheSameOrder)
+{
+	// below 2^32 values the value type makes no difference to the draws.
+	mabz::LazyShuffle narrow(2000);
+	mabz::BasicLazyShuffle<long long> wide(2000);
+	std::mt19937_64 narrowEng(17);
+	std::mt19937_64 wideEng(17);
+	while (narrow.Remaining() > 0)
+	{
+		ASSERT_EQ(wide.Next(wideEng), static_cast<long long>(narrow.Next(narrowEng)));
+	}
+	EXPECT_EQ(wide.Remaining(), 0);
+}
+
+TEST(LazyShuffleTest, TestEmpty)
+{
+	mabz::LazyShuffle shuffle(0);
+	std::mt19937_64 randEng;
+	EXPECT_EQ(shuffle.Remaining(), 0);
+	ASSERT_THROW(shuffle.Next(randEng), mabz::UnexpectedMethodCall);
+	shuffle.Rewind();
+}
+
+} /* anon namespace */
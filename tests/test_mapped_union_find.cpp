@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/compact_union_find.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/mapped_union_find.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+std::string TempPath(const std::string& name)
+{
+	return ::testing::TempDir() + "algo_lib_" + name;
+}
+
+TEST(MappedUnionFindTest, TestSaveAndOpen)
+{
+	const std::string path = TempPath("uf_snapshot.bin");
+	const int n{1000};
+	mabz::UnionFind<> uf(n);
+	for (int i = 0; i < 600; i++) uf.Union((i * 31) % n, (i * 57 + 3) % n);
+
+	mabz::MappedUnionFind<std::uint32_t>::Save(uf, path);
+
+	{
+		auto mapped = mabz::MappedUnionFind<std::uint32_t>::Open(path);
+		EXPECT_FALSE(mapped.IsWritable());
+		ASSERT_EQ(mapped.Capacity(), static_cast<std::uint32_t>(n));
+		for (int i = 0; i < n; i++)
+		{
+			const int other = (i * 17) % n;
+			ASSERT_EQ(mapped.Connected(i, other), uf.Connected(i, other));
+			ASSERT_EQ(static_cast<int>(mapped.ComponentSize(i)), uf.ComponentSize(i));
+		}
+		ASSERT_THROW(mapped.Union(0, 1), mabz::UnexpectedMethodCall);
+		ASSERT_THROW(mapped.Connected(0, n), mabz::IndexOutOfRange);
+
+		// wrong index width for this file.
+		ASSERT_THROW(mabz::MappedUnionFind<std::uint64_t>::Open(path), mabz::FileError);
+	}
+
+	std::remove(path.c_str());
+}
+
+TEST(MappedUnionFindTest, TestBuildInsideFile)
+{
+	const std::string path = TempPath("uf_built.bin");
+	{
+		auto built = mabz::MappedUnionFind<std::uint64_t>::Create(path, 10);
+		EXPECT_TRUE(built.IsWritable());
+		built.Union(1, 2);
+		built.Union(2, 7);
+		built.Union(4, 5);
+		EXPECT_TRUE(built.Connected(1, 7));
+		built.Flush();
+	}
+	{
+		// reopen writable and carry on where we left off.
+		auto reopened = mabz::MappedUnionFind<std::uint64_t>::Open(path, true);
+		EXPECT_TRUE(reopened.Connected(7, 1));
+		EXPECT_EQ(reopened.ComponentSize(2), 3u);
+		reopened.Union(5, 7);
+	}
+	{
+		auto readOnly = mabz::MappedUnionFind<std::uint64_t>::Open(path);
+		EXPECT_TRUE(readOnly.Connected(4, 1));
+		EXPECT_FALSE(readOnly.Connected(0, 1));
+		EXPECT_EQ(readOnly.ComponentSize(4), 5u);
+	}
+	std::remove(path.c_str());
+}
+
+TEST(MappedUnionFindTest, TestMove)
+{
+	const std::string path = TempPath("uf_moved.bin");
+	const std::string otherPath = TempPath("uf_moved_other.bin");
+	{
+		auto built = mabz::MappedUnionFind<>::Create(path, 6);
+		built.Union(0, 5);
+		mabz::MappedUnionFind<> moved(std::move(built));
+		EXPECT_TRUE(moved.Connected(5, 0));
+		EXPECT_EQ(built.Capacity(), 0u);
+		ASSERT_THROW(built.Find(0), mabz::IndexOutOfRange);
+
+		auto other = mabz::MappedUnionFind<>::Create(otherPath, 2);
+		other = std::move(moved);
+		EXPECT_EQ(other.Capacity(), 6u);
+		other.Union(1, 5);
+		EXPECT_EQ(other.ComponentSize(0), 3u);
+		EXPECT_EQ(moved.Capacity(), 0u);
+		ASSERT_THROW(moved.Connected(0, 1), mabz::IndexOutOfRange);
+	}
+	std::remove(path.c_str());
+	std::remove(otherPath.c_str());
+}
+
+TEST(MappedUnionFindTest, TestBadFiles)
+{
+	ASSERT_THROW(mabz::MappedUnionFind<>::Open(TempPath("does_not_exist.bin")), mabz::FileError);
+
+	const std::string path = TempPath("not_a_snapshot.bin");
+	{
+		std::ofstream out(path, std::ios::binary);
+		out << "this is definitely not a union find snapshot";
+	}
+	ASSERT_THROW(mabz::MappedUnionFind<>::Open(path), mabz::FileError);
+	std::remove(path.c_str());
+}
+
+TEST(MappedUnionFindTest, TestSaveCompact)
+{
+	const std::string path = TempPath("uf_compact.bin");
+	mabz::CompactUnionFind<std::uint16_t> compact(50);
+	compact.Union(3, 4);
+	compact.Union(4, 49);
+	mabz::MappedUnionFind<std::uint16_t>::Save(compact, path);
+
+	auto mapped = mabz::MappedUnionFind<std::uint16_t>::Open(path);
+	EXPECT_TRUE(mapped.Connected(3, 49));
+	EXPECT_FALSE(mapped.Connected(3, 5));
+	EXPECT_EQ(mapped.ComponentSize(49), 3);
+	std::remove(path.c_str());
+}
+
+} /* anon namespace */
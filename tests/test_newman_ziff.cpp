@@ -0,0 +1,105 @@
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/newman_ziff.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+
+TEST(NewmanZiffTest, TestConstructorThrows)
+{
+	ASSERT_THROW(nsperc::NewmanZiff(0, 5), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::NewmanZiff(5, 0), mabz::IllegalArgumentException);
+	// 46341^2 + 1 is past INT_MAX; checked before anything is allocated.
+	ASSERT_THROW(nsperc::NewmanZiff(46341, 1), mabz::IllegalArgumentException);
+}
+
+TEST(NewmanZiffTest, TestBoundaryOccupations)
+{
+	const int n{8};
+	nsperc::NewmanZiff nz(n, 10);
+
+	const auto& empty = nz.AtOccupation(0);
+	EXPECT_EQ(empty.mSpanning, 0);
+	EXPECT_EQ(empty.mLargestClusterFraction, 0);
+	EXPECT_EQ(empty.mMeanClusterSize, 0);
+
+	// one open cell can't span an 8 high grid.
+	EXPECT_EQ(nz.AtOccupation(1).mSpanning, 0);
+	EXPECT_DOUBLE_EQ(nz.AtOccupation(1).mLargestClusterFraction, 1.0 / (n*n));
+
+	// fewer than n open cells can never span.
+	EXPECT_EQ(nz.AtOccupation(n-1).mSpanning, 0);
+
+	const auto& full = nz.AtOccupation(n*n);
+	EXPECT_EQ(full.mSpanning, 1);
+	EXPECT_DOUBLE_EQ(full.mLargestClusterFraction, 1);
+	EXPECT_EQ(full.mMeanClusterSize, 0);
+
+	ASSERT_THROW(nz.AtOccupation(n*n + 1), mabz::IllegalArgumentException);
+
+	// spanning can only become more likely as cells open.
+	for (int k = 1; k <= n*n; k++)
+	{
+		ASSERT_GE(nz.AtOccupation(k).mSpanning, nz.AtOccupation(k-1).mSpanning);
+	}
+}
+
+TEST(NewmanZiffTest, TestBinomialWeights)
+{
+	for (double p : {0.0, 0.01, 0.3, 0.5927, 0.99, 1.0})
+	{
+		const int cells{400};
+		const auto w = nsperc::NewmanZiff::BinomialWeights(cells, p);
+		ASSERT_EQ(w.size(), static_cast<std::size_t>(cells + 1));
+		EXPECT_NEAR(std::accumulate(w.begin(), w.end(), 0.0), 1.0, 1e-12);
+
+		double mean{0};
+		for (int k = 0; k <= cells; k++) mean += k * w[k];
+		EXPECT_NEAR(mean, cells * p, 1e-6);
+	}
+
+	// exact small case: B(3, 0.5) = 1/8, 3/8, 3/8, 1/8.
+	const auto w = nsperc::NewmanZiff::BinomialWeights(3, 0.5);
+	EXPECT_NEAR(w[0], 0.125, 1e-12);
+	EXPECT_NEAR(w[1], 0.375, 1e-12);
+	EXPECT_NEAR(w[2], 0.375, 1e-12);
+	EXPECT_NEAR(w[3], 0.125, 1e-12);
+
+	ASSERT_THROW(nsperc::NewmanZiff::BinomialWeights(3, 1.5), mabz::IllegalArgumentException);
+}
+
+TEST(NewmanZiffTest, TestCanonicalCurve)
+{
+	nsperc::NewmanZiff nz(32, 40, 1234);
+
+	EXPECT_EQ(nz.At(0).mSpanning, 0);
+	EXPECT_EQ(nz.At(1).mSpanning, 1);
+	EXPECT_LT(nz.At(0.4).mSpanning, 0.05);
+	EXPECT_GT(nz.At(0.8).mSpanning, 0.95);
+
+	// the spanning curve crosses a half close to the known threshold ~0.5927.
+	EXPECT_LT(nz.At(0.54).mSpanning, 0.5);
+	EXPECT_GT(nz.At(0.65).mSpanning, 0.5);
+
+	// and is smooth and non-decreasing in p.
+	double previous{0};
+	for (int i = 0; i <= 100; i++)
+	{
+		const double spanning = nz.At(i / 100.0).mSpanning;
+		ASSERT_GE(spanning, previous - 1e-12);
+		previous = spanning;
+	}
+
+	// same seed, same answer.
+	nsperc::NewmanZiff again(32, 40, 1234);
+	EXPECT_EQ(again.At(0.59).mSpanning, nz.At(0.59).mSpanning);
+	EXPECT_EQ(again.At(0.59).mMeanClusterSize, nz.At(0.59).mMeanClusterSize);
+}
+
+} /* anon namespace */
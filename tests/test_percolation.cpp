@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <algo_lib/exceptions.h>
@@ -81,4 +88,261 @@ TEST(PercolationTest, TestPercolateCase)
 	ASSERT_FALSE(p.IsFull(5, 1));
 }
 
+TEST(PercolationTest, TestAlternativeUnionFindPolicies)
+{
+	nsperc::BasicPercolation<mabz::uf_policy::QuickFind> quickFind(3);
+	nsperc::BasicPercolation<mabz::uf_policy::PathSplitting> splitting(3);
+	for (int row = 1; row <= 3; row++)
+	{
+		ASSERT_FALSE(quickFind.DoesPercolate());
+		ASSERT_FALSE(splitting.DoesPercolate());
+		quickFind.Open(row, 2);
+		splitting.Open(row, 2);
+	}
+	ASSERT_TRUE(quickFind.DoesPercolate());
+	ASSERT_TRUE(splitting.DoesPercolate());
+	ASSERT_FALSE(splitting.IsFull(2, 1));
+}
+
+TEST(PercolationTest, TestOpenCountsAndRowQueries)
+{
+	// wider than one 64-bit word per row.
+	const int n{70};
+	nsperc::Percolation p(n);
+	ASSERT_EQ(p.GetNumberOfOpenSites(), 0);
+	ASSERT_FALSE(p.IsAnyOpenInRow(1));
+
+	p.Open(1, 70);
+	p.Open(1, 70);
+	p.Open(1, 1);
+	p.Open(3, 64);
+	p.Open(3, 65);
+	ASSERT_EQ(p.GetNumberOfOpenSites(), 4);
+	ASSERT_TRUE(p.IsAnyOpenInRow(1));
+	ASSERT_FALSE(p.IsAnyOpenInRow(2));
+	ASSERT_EQ(p.GetNumberOfOpenSitesInRow(1), 2);
+	ASSERT_EQ(p.GetNumberOfOpenSitesInRow(3), 2);
+	ASSERT_EQ(p.GetNumberOfOpenSitesInRow(70), 0);
+	ASSERT_TRUE(p.IsOpen(3, 65));
+	ASSERT_FALSE(p.IsOpen(3, 66));
+
+	ASSERT_THROW(p.IsAnyOpenInRow(0), mabz::IllegalArgumentException);
+	ASSERT_THROW(p.GetNumberOfOpenSitesInRow(71), mabz::IllegalArgumentException);
+
+	p.ResetGrid();
+	ASSERT_EQ(p.GetNumberOfOpenSites(), 0);
+	ASSERT_FALSE(p.IsOpen(1, 70));
+}
+
+TEST(PercolationTest, TestCellLayoutsAgree)
+{
+	// 37 isn't a power of two or a whole number of tiles, so both padded
+	// layouts have slots that are never opened.
+	const int n{37};
+	namespace layout = nsperc::cell_index;
+	nsperc::Percolation rowMajor(n);
+	nsperc::BasicPercolation<mabz::DefaultUnionFindPolicy, layout::Morton> morton(n);
+	nsperc::BasicPercolation<mabz::DefaultUnionFindPolicy, layout::BlockedTiles<8> > tiles(n);
+
+	std::vector<std::pair<int,int> > cells;
+	for (int r = 1; r <= n; r++)
+	{
+		for (int c = 1; c <= n; c++) cells.emplace_back(r, c);
+	}
+	std::shuffle(cells.begin(), cells.end(), std::default_random_engine{});
+
+	for (std::size_t i = 0; i < cells.size(); i++)
+	{
+		rowMajor.Open(cells[i].first, cells[i].second);
+		morton.Open(cells[i].first, cells[i].second);
+		tiles.Open(cells[i].first, cells[i].second);
+		ASSERT_EQ(morton.DoesPercolate(), rowMajor.DoesPercolate());
+		ASSERT_EQ(tiles.DoesPercolate(), rowMajor.DoesPercolate());
+		if (i % 97 == 0)
+		{
+			for (int r = 1; r <= n; r++)
+			{
+				ASSERT_EQ(morton.IsFull(r, 5), rowMajor.IsFull(r, 5));
+				ASSERT_EQ(tiles.IsFull(r, 30), rowMajor.IsFull(r, 30));
+			}
+		}
+	}
+	ASSERT_TRUE(morton.DoesPercolate());
+	ASSERT_TRUE(tiles.DoesPercolate());
+}
+
+TEST(PercolationTest, TestTooBigForIntNodesThrows)
+{
+	// 46341^2 + 2 is past INT_MAX; this used to overflow rather than throw.
+	// The check comes before anything is allocated.
+	ASSERT_THROW(nsperc::Percolation(46341), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::BasicPercolation<nsperc::CompactStorage<std::uint32_t> >(46341),
+		mabz::IllegalArgumentException);
+	// Morton pads 40000 up to 65536 a side, so it runs out sooner.
+	ASSERT_THROW(
+		(nsperc::BasicPercolation<mabz::DefaultUnionFindPolicy, nsperc::cell_index::Morton>(40000)),
+		mabz::IllegalArgumentException);
+}
+
+TEST(PercolationTest, TestCompactStorageAgrees)
+{
+	const int n{41};
+	nsperc::Percolation reference(n);
+	nsperc::BasicPercolation<nsperc::CompactStorage<std::uint32_t> > compact(n);
+	nsperc::LargePercolation large(n);
+
+	std::vector<std::pair<int,int> > cells;
+	for (int r = 1; r <= n; r++)
+	{
+		for (int c = 1; c <= n; c++) cells.emplace_back(r, c);
+	}
+	std::shuffle(cells.begin(), cells.end(), std::default_random_engine{7});
+
+	for (std::size_t i = 0; i < cells.size(); i++)
+	{
+		reference.Open(cells[i].first, cells[i].second);
+		compact.Open(cells[i].first, cells[i].second);
+		large.Open(cells[i].first, cells[i].second);
+		ASSERT_EQ(compact.DoesPercolate(), reference.DoesPercolate());
+		ASSERT_EQ(large.DoesPercolate(), reference.DoesPercolate());
+		if (i % 89 == 0)
+		{
+			for (int c = 1; c <= n; c++)
+			{
+				ASSERT_EQ(compact.IsFull(n / 2, c), reference.IsFull(n / 2, c));
+				ASSERT_EQ(large.IsFull(n, c), reference.IsFull(n, c));
+			}
+		}
+	}
+	ASSERT_EQ(large.GetNumberOfOpenSites(), static_cast<long long>(n) * n);
+
+	large.ResetGrid();
+	ASSERT_EQ(large.GetNumberOfOpenSites(), 0);
+	ASSERT_FALSE(large.DoesPercolate());
+}
+
+TEST(PercolationStatsTest, TestConstructorThrows)
+{
+	ASSERT_THROW(nsperc::PercolationStats(0, 5), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::PercolationStats(5, 0), mabz::IllegalArgumentException);
+}
+
+TEST(PercolationStatsTest, TestSameResultsForAnyThreadCount)
+{
+	const nsperc::PercolationStats serial(30, 21, 1);
+	EXPECT_NEAR(serial.Mean(), 0.5927, 0.05);
+	EXPECT_GT(serial.Stdev(), 0);
+
+	// bit-identical, not just close: every trial has its own engine.
+	for (int threads : {2, 3, 8, 21, 40})
+	{
+		const nsperc::PercolationStats parallel(30, 21, threads);
+		EXPECT_EQ(parallel.Mean(), serial.Mean()) << threads;
+		EXPECT_EQ(parallel.Stdev(), serial.Stdev()) << threads;
+		EXPECT_EQ(parallel.ConfidenceLow(), serial.ConfidenceLow()) << threads;
+		EXPECT_EQ(parallel.ConfidenceHigh(), serial.ConfidenceHigh()) << threads;
+	}
+
+	const nsperc::PercolationStats reseeded(30, 21, 1, 1);
+	EXPECT_NE(reseeded.Mean(), serial.Mean());
+}
+
+TEST(PercolationStatsTest, TestEveryEngine)
+{
+	const nsperc::BasicPercolationStats<mabz::rng::Pcg64> pcg(30, 40, 2, 9);
+	const nsperc::BasicPercolationStats<mabz::rng::Philox4x32> philox(30, 40, 2, 9);
+	EXPECT_NEAR(pcg.Mean(), 0.5927, 0.05);
+	EXPECT_NEAR(philox.Mean(), 0.5927, 0.05);
+	EXPECT_NE(pcg.Mean(), philox.Mean());
+}
+
+TEST(PercolationStatsTest, TestLargeRunnerAgrees)
+{
+	// past n = 46340 the stats run on LargePercolation with long long cells;
+	// grids that big don't fit in a test, but the large runner has to give the
+	// same thresholds as the int one for the same engine.
+	EXPECT_FALSE(nsperc::detail::NeedsLargePercolation(46340));
+	EXPECT_TRUE(nsperc::detail::NeedsLargePercolation(46341));
+	EXPECT_TRUE(nsperc::detail::NeedsLargePercolation(100000));
+
+	nsperc::detail::SmallPercolationTrialRunner small(40);
+	nsperc::detail::LargePercolationTrialRunner large(40);
+	for (std::uint64_t seed = 0; seed < 5; seed++)
+	{
+		mabz::rng::Xoshiro256StarStar smallEng(seed);
+		mabz::rng::Xoshiro256StarStar largeEng(seed);
+		ASSERT_EQ(large.Run(largeEng), small.Run(smallEng)) << seed;
+	}
+}
+
+TEST(PercolationStatsTest, TestShardsAreSlicesOfOneRun)
+{
+	// three one-trial shards starting at trials 0, 1 and 2 of the same seed
+	// are the three trials of a single run.
+	const nsperc::PercolationStats whole(25, 3, 1, 4);
+	double shardSum{0};
+	for (std::uint64_t firstTrial = 0; firstTrial < 3; firstTrial++)
+	{
+		shardSum += nsperc::PercolationStats(25, 1, 1, 4, firstTrial).Mean();
+	}
+	EXPECT_DOUBLE_EQ(shardSum / 3, whole.Mean());
+
+	const nsperc::PercolationStats lastTwo(25, 2, 2, 4, 1);
+	EXPECT_DOUBLE_EQ((shardSum - nsperc::PercolationStats(25, 1, 1, 4, 0).Mean()) / 2, lastTwo.Mean());
+}
+
+TEST(PercolationStatsTest, TestUntilHalfWidthThrows)
+{
+	ASSERT_THROW(nsperc::PercolationStats::UntilHalfWidth(0, 0.01), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::PercolationStats::UntilHalfWidth(10, 0), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::PercolationStats::UntilHalfWidth(10, 0.01, std::chrono::milliseconds(-1)),
+		mabz::IllegalArgumentException);
+}
+
+TEST(PercolationStatsTest, TestUntilHalfWidthStopsNearTheTarget)
+{
+	const double target{0.004};
+	const auto serial = nsperc::PercolationStats::UntilHalfWidth(20, target, std::chrono::milliseconds::max(), 1);
+	EXPECT_LE(serial.ConfidenceHigh() - serial.Mean(), target);
+	EXPECT_NEAR(serial.Mean(), 0.5927, 0.02);
+
+	// enough trials for the target by the final spread, but not many more.
+	const double ratio{1.96 * serial.Stdev() / target};
+	EXPECT_GE(serial.Trials(), static_cast<long long>(ratio * ratio));
+	EXPECT_LE(serial.Trials(), static_cast<long long>(1.25 * ratio * ratio) + nsperc::PercolationStats::kMinBatch);
+
+	// with no time limit, the batches don't depend on the thread count.
+	const auto parallel = nsperc::PercolationStats::UntilHalfWidth(20, target, std::chrono::milliseconds::max(), 3);
+	EXPECT_EQ(parallel.Trials(), serial.Trials());
+	EXPECT_EQ(parallel.Mean(), serial.Mean());
+	EXPECT_EQ(parallel.Stdev(), serial.Stdev());
+}
+
+TEST(PercolationStatsTest, TestUntilHalfWidthShards)
+{
+	// an adaptive run starting at firstTrial runs the same trials as a fixed
+	// count run from there.
+	const std::uint64_t firstTrial{1000};
+	const auto adaptive = nsperc::PercolationStats::UntilHalfWidth(
+		20, 0.01, std::chrono::milliseconds::max(), 2, 6, firstTrial);
+	const nsperc::PercolationStats fixed(20, static_cast<int>(adaptive.Trials()), 1, 6, firstTrial);
+	EXPECT_EQ(adaptive.Mean(), fixed.Mean());
+	EXPECT_EQ(adaptive.Stdev(), fixed.Stdev());
+
+	const auto fromZero = nsperc::PercolationStats::UntilHalfWidth(
+		20, 0.01, std::chrono::milliseconds::max(), 2, 6);
+	EXPECT_NE(fromZero.Mean(), adaptive.Mean());
+}
+
+TEST(PercolationStatsTest, TestUntilHalfWidthTimeBudget)
+{
+	// an impossible target with no time: one batch and done.
+	const auto stats = nsperc::PercolationStats::UntilHalfWidth(20, 1e-9, std::chrono::milliseconds(0));
+	EXPECT_EQ(stats.Trials(), nsperc::PercolationStats::kMinBatch);
+	EXPECT_GT(stats.ConfidenceHigh() - stats.Mean(), 1e-9);
+
+	// the fixed count constructor runs exactly what it is asked to.
+	EXPECT_EQ(nsperc::PercolationStats(10, 7, 2).Trials(), 7);
+}
+
 } /* anon namespace */
\ No newline at end of file
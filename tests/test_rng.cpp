@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/rng.h>
+
+namespace {
+
+namespace rng = mabz::rng;
+
+TEST(RngTest, TestXoshiroReferenceOutputs)
+{
+	// from the reference xoshiro256starstar.c with s = {1, 2, 3, 4}.
+	rng::Xoshiro256StarStar randEng(1, 2, 3, 4);
+	EXPECT_EQ(randEng(), 11520ull);
+	EXPECT_EQ(randEng(), 0ull);
+	EXPECT_EQ(randEng(), 1509978240ull);
+	EXPECT_EQ(randEng(), 1215971899390074240ull);
+}
+
+TEST(RngTest, TestPcgReferenceOutputs)
+{
+	// the pcg-cpp demo's pcg64 rng(42u, 54u).
+	rng::Pcg64 randEng(42, 54);
+	EXPECT_EQ(randEng(), 0x86B1DA1D72062B68ull);
+	EXPECT_EQ(randEng(), 0x1304AA46C9853D39ull);
+	EXPECT_EQ(randEng(), 0xA3670E9E0DD50358ull);
+	EXPECT_EQ(randEng(), 0xF9090E529A7DAE00ull);
+}
+
+TEST(RngTest, TestPhiloxKnownAnswers)
+{
+	// Random123's known answer tests for philox4x32-10.
+	rng::Philox4x32::Block out;
+	const std::uint32_t zeroKey[2] = {0, 0};
+	rng::Philox4x32::Encrypt(zeroKey, 0, 0, out);
+	EXPECT_EQ(out[0], 0x6627E8D5u);
+	EXPECT_EQ(out[1], 0xE169C58Du);
+	EXPECT_EQ(out[2], 0xBC57AC4Cu);
+	EXPECT_EQ(out[3], 0x9B00DBD8u);
+
+	const std::uint32_t piKey[2] = {0xA4093822u, 0x299F31D0u};
+	rng::Philox4x32::Encrypt(piKey, 0x85A308D3243F6A88ull, 0x0370734413198A2Eull, out);
+	EXPECT_EQ(out[0], 0xD16CFE09u);
+	EXPECT_EQ(out[1], 0x94FDCCEBu);
+	EXPECT_EQ(out[2], 0x5001E420u);
+	EXPECT_EQ(out[3], 0x24126EA1u);
+
+	// the engine hands block 0 of key = seed out as two 64-bit words.
+	rng::Philox4x32 randEng(0);
+	EXPECT_EQ(randEng(), 0xE169C58D6627E8D5ull);
+	EXPECT_EQ(randEng(), 0x9B00DBD8BC57AC4Cull);
+}
+
+template <typename Engine>
+void ExpectDiscardMatchesCalls(std::uint64_t seed)
+{
+	for (std::uint64_t start : {0, 1, 2, 3})
+	{
+		for (std::uint64_t skip : {0, 1, 2, 5, 64, 1001})
+		{
+			Engine stepped(seed);
+			Engine discarded(seed);
+			for (std::uint64_t i = 0; i < start; i++)
+			{
+				stepped();
+				discarded();
+			}
+			for (std::uint64_t i = 0; i < skip; i++) stepped();
+			discarded.Discard(skip);
+			for (int i = 0; i < 4; i++) ASSERT_EQ(discarded(), stepped()) << start << " " << skip;
+		}
+	}
+}
+
+TEST(RngTest, TestDiscardMatchesCalls)
+{
+	ExpectDiscardMatchesCalls<rng::Xoshiro256StarStar>(7);
+	ExpectDiscardMatchesCalls<rng::Pcg64>(7);
+	ExpectDiscardMatchesCalls<rng::Philox4x32>(7);
+}
+
+template <typename Engine>
+void ExpectStreamsDiffer()
+{
+	Engine first(3);
+	Engine second(3);
+	second.Jump();
+	Engine third(3);
+	third.Jump(2);
+	Engine secondTwice(3);
+	secondTwice.Jump();
+	secondTwice.Jump();
+
+	std::vector<std::uint64_t> a, b, c;
+	for (int i = 0; i < 1000; i++)
+	{
+		a.push_back(first());
+		b.push_back(second());
+		c.push_back(third());
+		ASSERT_EQ(secondTwice(), c.back());
+	}
+	std::sort(a.begin(), a.end());
+	std::sort(b.begin(), b.end());
+	std::sort(c.begin(), c.end());
+	std::vector<std::uint64_t> common;
+	std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+	std::set_intersection(a.begin(), a.end(), c.begin(), c.end(), std::back_inserter(common));
+	std::set_intersection(b.begin(), b.end(), c.begin(), c.end(), std::back_inserter(common));
+	EXPECT_TRUE(common.empty());
+}
+
+TEST(RngTest, TestJumpGivesSeparateStreams)
+{
+	ExpectStreamsDiffer<rng::Xoshiro256StarStar>();
+	ExpectStreamsDiffer<rng::Pcg64>();
+	ExpectStreamsDiffer<rng::Philox4x32>();
+}
+
+TEST(RngTest, TestJumpIsAFixedDistance)
+{
+	// jumping then stepping is the same as stepping then jumping.
+	rng::Xoshiro256StarStar a(11);
+	rng::Xoshiro256StarStar b(11);
+	a.Jump();
+	a();
+	b();
+	b.Jump();
+	EXPECT_TRUE(a == b);
+
+	// xoshiro's Jump and Discard are O(log k), so far streams are cheap to
+	// reach, and they compose.
+	rng::Xoshiro256StarStar far(11);
+	far.Jump(3000000000ull);
+	rng::Xoshiro256StarStar farInSteps(11);
+	for (int i = 0; i < 3; i++) farInSteps.Jump(1000000000ull);
+	EXPECT_TRUE(far == farInSteps);
+	far.Discard((std::uint64_t{1} << 40) + 3);
+	farInSteps.Discard(std::uint64_t{1} << 39);
+	farInSteps.Discard((std::uint64_t{1} << 39) + 3);
+	EXPECT_TRUE(far == farInSteps);
+
+	// two jumps of 2^63 streams are 2^192 outputs: the reference long_jump(),
+	// which gives these outputs from s = {1, 2, 3, 4}.
+	rng::Xoshiro256StarStar longJumped(1, 2, 3, 4);
+	longJumped.Jump(std::uint64_t{1} << 63);
+	longJumped.Jump(std::uint64_t{1} << 63);
+	EXPECT_EQ(longJumped(), 0x527752A1D792704Dull);
+	EXPECT_EQ(longJumped(), 0xD8D8BDEC57599E64ull);
+
+	// for PCG, Jump(3) skips 3 * 2^64 outputs: six discards of 2^63.
+	rng::Pcg64 c(11);
+	rng::Pcg64 d(11);
+	c.Jump(3);
+	for (int i = 0; i < 6; i++) d.Discard(std::uint64_t{1} << 63);
+	EXPECT_TRUE(c == d);
+}
+
+TEST(RngTest, TestBoundedIsInRangeAndUnbiased)
+{
+	rng::Pcg64 randEng(5);
+	const std::uint32_t range{6};
+	std::vector<int> counts(range, 0);
+	const int draws{60000};
+	for (int i = 0; i < draws; i++)
+	{
+		const std::uint32_t value{rng::Bounded32([&]() { return static_cast<std::uint32_t>(randEng()); }, range)};
+		ASSERT_LT(value, range);
+		counts[value]++;
+	}
+	for (int count : counts) EXPECT_NEAR(count, draws / range, draws / range / 10);
+
+	// a range just past half of 2^64 rejects nearly half of all draws.
+	const std::uint64_t bigRange{(std::uint64_t{1} << 63) + 12345};
+	int upperHalf{0};
+	for (int i = 0; i < 10000; i++)
+	{
+		const std::uint64_t value{rng::Bounded(randEng, bigRange)};
+		ASSERT_LT(value, bigRange);
+		upperHalf += value >= bigRange / 2 ? 1 : 0;
+	}
+	EXPECT_NEAR(upperHalf, 5000, 300);
+	EXPECT_EQ(rng::Bounded(randEng, 1), 0ull);
+}
+
+TEST(RngTest, TestWorksWithStandardLibrary)
+{
+	std::vector<int> values(100);
+	std::iota(values.begin(), values.end(), 0);
+	rng::Xoshiro256StarStar randEng(1);
+	std::shuffle(values.begin(), values.end(), randEng);
+	EXPECT_FALSE(std::is_sorted(values.begin(), values.end()));
+
+	rng::Philox4x32 philox(1);
+	const double u{std::uniform_real_distribution<double>(0, 1)(philox)};
+	EXPECT_GE(u, 0);
+	EXPECT_LT(u, 1);
+}
+
+} /* anon namespace */
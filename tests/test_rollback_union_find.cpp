@@ -0,0 +1,81 @@
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/rollback_union_find.h>
+
+namespace {
+
+TEST(RollbackUnionFindTest, TestRollback)
+{
+	mabz::RollbackUnionFind uf(8);
+	EXPECT_EQ(uf.ComponentCount(), 8);
+
+	EXPECT_TRUE(uf.Union(0, 1));
+	EXPECT_TRUE(uf.Union(2, 3));
+	const std::size_t prefix = uf.Checkpoint();
+
+	EXPECT_TRUE(uf.Union(1, 2));
+	EXPECT_FALSE(uf.Union(0, 3));
+	const std::size_t middle = uf.Checkpoint();
+	EXPECT_TRUE(uf.Union(4, 5));
+	EXPECT_TRUE(uf.Union(5, 0));
+	EXPECT_TRUE(uf.Connected(4, 3));
+	EXPECT_EQ(uf.ComponentCount(), 3);
+
+	uf.RollbackTo(middle);
+	EXPECT_TRUE(uf.Connected(0, 3));
+	EXPECT_FALSE(uf.Connected(4, 5));
+	EXPECT_FALSE(uf.Connected(4, 0));
+	EXPECT_EQ(uf.ComponentCount(), 5);
+
+	uf.RollbackTo(prefix);
+	EXPECT_TRUE(uf.Connected(0, 1));
+	EXPECT_TRUE(uf.Connected(2, 3));
+	EXPECT_FALSE(uf.Connected(1, 2));
+	EXPECT_EQ(uf.ComponentCount(), 6);
+
+	// and forwards again down a different branch.
+	uf.Union(3, 7);
+	EXPECT_TRUE(uf.Connected(2, 7));
+	uf.Undo();
+	EXPECT_FALSE(uf.Connected(2, 7));
+
+	uf.RollbackTo(0);
+	EXPECT_EQ(uf.ComponentCount(), 8);
+	EXPECT_FALSE(uf.Connected(0, 1));
+}
+
+TEST(RollbackUnionFindTest, TestRollbackRestoresExactState)
+{
+	const int n{200};
+	mabz::RollbackUnionFind uf(n);
+	for (int i = 0; i < 80; i++) uf.Union((i * 7) % n, (i * 13 + 1) % n);
+
+	std::vector<int> roots;
+	for (int i = 0; i < n; i++) roots.push_back(uf.Find(i));
+	const std::size_t checkpoint = uf.Checkpoint();
+	const int components = uf.ComponentCount();
+
+	for (int i = 0; i < 150; i++) uf.Union((i * 11) % n, (i * 29 + 5) % n);
+	uf.RollbackTo(checkpoint);
+
+	// no compression, so the roots themselves come back, not just the partition.
+	for (int i = 0; i < n; i++) ASSERT_EQ(uf.Find(i), roots[i]);
+	EXPECT_EQ(uf.ComponentCount(), components);
+}
+
+TEST(RollbackUnionFindTest, TestThrows)
+{
+	mabz::RollbackUnionFind uf(3);
+	ASSERT_THROW(uf.Undo(), mabz::EmptyContainer);
+	uf.Union(0, 1);
+	ASSERT_THROW(uf.RollbackTo(2), mabz::IllegalArgumentException);
+	ASSERT_THROW(uf.Union(0, 3), mabz::IndexOutOfRange);
+	ASSERT_THROW(uf.Connected(-1, 0), mabz::IndexOutOfRange);
+}
+
+} /* anon namespace */
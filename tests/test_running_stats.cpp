@@ -0,0 +1,53 @@
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/running_stats.h>
+
+namespace {
+
+TEST(RunningStatsTest, TestEmptyAndSingle)
+{
+	mabz::RunningStats stats;
+	EXPECT_EQ(stats.Count(), 0);
+	EXPECT_TRUE(std::isnan(stats.Mean()));
+	EXPECT_TRUE(std::isnan(stats.Variance()));
+
+	stats.Add(3.5);
+	EXPECT_EQ(stats.Count(), 1);
+	EXPECT_EQ(stats.Mean(), 3.5);
+	EXPECT_TRUE(std::isnan(stats.Variance()));
+}
+
+TEST(RunningStatsTest, TestMatchesTwoPass)
+{
+	const std::vector<double> samples{0.59, 0.61, 0.57, 0.6, 0.62, 0.58, 0.593};
+	mabz::RunningStats stats;
+	double sum{0};
+	for (double x : samples)
+	{
+		stats.Add(x);
+		sum += x;
+	}
+	const double mean{sum / samples.size()};
+	double sumSq{0};
+	for (double x : samples) sumSq += (x - mean) * (x - mean);
+	const double variance{sumSq / (samples.size() - 1)};
+
+	EXPECT_EQ(stats.Count(), static_cast<long long>(samples.size()));
+	EXPECT_NEAR(stats.Mean(), mean, 1e-15);
+	EXPECT_NEAR(stats.Variance(), variance, 1e-15);
+	EXPECT_NEAR(stats.HalfWidth95(), 1.96 * std::sqrt(variance / samples.size()), 1e-15);
+}
+
+TEST(RunningStatsTest, TestStableWithLargeOffset)
+{
+	// the naive E[x^2] - E[x]^2 loses every digit here.
+	mabz::RunningStats stats;
+	for (int i = 0; i < 1000; i++) stats.Add(1e9 + (i % 2 == 0 ? 1 : -1));
+	EXPECT_NEAR(stats.Mean(), 1e9, 1e-6);
+	EXPECT_NEAR(stats.Variance(), 1000.0 / 999.0, 1e-6);
+}
+
+} /* anon namespace */
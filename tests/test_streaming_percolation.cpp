@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/exceptions.h>
+#include <algo_lib/streaming_percolation.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+
+std::string TempPath(const std::string& name)
+{
+	return ::testing::TempDir() + "algo_lib_" + name;
+}
+
+struct Expected
+{
+	bool mPercolates{false};
+	long long mOpen{0};
+	long long mClusters{0};
+	long long mLargest{0};
+};
+
+// labels the whole grid in memory for comparison.
+Expected LabelInMemory(const std::vector<std::vector<unsigned char>>& grid)
+{
+	const int rows = static_cast<int>(grid.size());
+	const int cols = static_cast<int>(grid[0].size());
+	mabz::UnionFind<> uf(rows * cols);
+	for (int r = 0; r < rows; r++)
+	{
+		for (int c = 0; c < cols; c++)
+		{
+			if (!grid[r][c]) continue;
+			if (c > 0 && grid[r][c-1]) uf.Union(r*cols + c, r*cols + c-1);
+			if (r > 0 && grid[r-1][c]) uf.Union(r*cols + c, (r-1)*cols + c);
+		}
+	}
+
+	Expected expected;
+	std::vector<int> sizes(rows * cols, 0);
+	for (int r = 0; r < rows; r++)
+	{
+		for (int c = 0; c < cols; c++)
+		{
+			if (!grid[r][c]) continue;
+			expected.mOpen++;
+			const int root = uf.Find(r*cols + c);
+			if (sizes[root]++ == 0) expected.mClusters++;
+			expected.mLargest = std::max<long long>(expected.mLargest, sizes[root]);
+		}
+	}
+	for (int top = 0; top < cols; top++)
+	{
+		for (int bottom = 0; bottom < cols; bottom++)
+		{
+			if (grid[0][top] && grid[rows-1][bottom] && uf.Connected(top, (rows-1)*cols + bottom))
+			{
+				expected.mPercolates = true;
+			}
+		}
+	}
+	return expected;
+}
+
+std::vector<std::vector<unsigned char>> RandomGrid(int rows, int cols, double p, unsigned seed)
+{
+	std::mt19937 randEng(seed);
+	std::bernoulli_distribution open(p);
+	std::vector<std::vector<unsigned char>> grid(rows, std::vector<unsigned char>(cols));
+	for (auto& row : grid)
+	{
+		for (auto& cell : row) cell = open(randEng) ? 1 : 0;
+	}
+	return grid;
+}
+
+TEST(StreamingPercolationTest, TestConstructorThrows)
+{
+	ASSERT_THROW(nsperc::StreamingPercolation(0), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::StreamingPercolation(-3), mabz::IllegalArgumentException);
+}
+
+TEST(StreamingPercolationTest, TestResultsOnlyAfterFinish)
+{
+	nsperc::StreamingPercolation perc(3);
+	const unsigned char row[] = {1, 0, 1};
+	perc.AddRow(row);
+	ASSERT_THROW(perc.DoesPercolate(), mabz::UnexpectedMethodCall);
+	ASSERT_THROW(perc.GetNumberOfClusters(), mabz::UnexpectedMethodCall);
+
+	perc.Finish();
+	EXPECT_TRUE(perc.DoesPercolate());
+	EXPECT_EQ(perc.GetNumberOfOpenSites(), 2);
+	EXPECT_EQ(perc.GetNumberOfClusters(), 2);
+	EXPECT_EQ(perc.GetLargestClusterSize(), 1);
+	ASSERT_THROW(perc.AddRow(row), mabz::UnexpectedMethodCall);
+	ASSERT_THROW(perc.Finish(), mabz::UnexpectedMethodCall);
+}
+
+TEST(StreamingPercolationTest, TestUShapeJoinsLate)
+{
+	// the two arms are separate clusters until the last row joins them.
+	const std::vector<std::vector<unsigned char>> grid{
+		{1, 0, 1},
+		{1, 0, 1},
+		{1, 1, 1},
+		{0, 0, 0},
+		{0, 1, 0},
+	};
+	auto perc = nsperc::StreamingPercolation::Analyze(3, 5,
+		[&grid](long long row, unsigned char* cells) { std::copy(grid[row].begin(), grid[row].end(), cells); });
+	EXPECT_EQ(perc.Rows(), 5);
+	EXPECT_FALSE(perc.DoesPercolate());
+	EXPECT_EQ(perc.GetNumberOfOpenSites(), 8);
+	EXPECT_EQ(perc.GetNumberOfClusters(), 2);
+	EXPECT_EQ(perc.GetLargestClusterSize(), 7);
+}
+
+TEST(StreamingPercolationTest, TestMatchesInMemoryLabelling)
+{
+	for (unsigned seed = 0; seed < 40; seed++)
+	{
+		const int rows = 5 + seed % 17;
+		const int cols = 3 + seed % 11;
+		const double p = 0.45 + 0.01 * (seed % 25);
+		const auto grid = RandomGrid(rows, cols, p, seed);
+		const Expected expected = LabelInMemory(grid);
+
+		auto perc = nsperc::StreamingPercolation::Analyze(cols, rows,
+			[&grid](long long row, unsigned char* cells) { std::copy(grid[row].begin(), grid[row].end(), cells); });
+		EXPECT_EQ(perc.DoesPercolate(), expected.mPercolates) << "seed " << seed;
+		EXPECT_EQ(perc.GetNumberOfOpenSites(), expected.mOpen) << "seed " << seed;
+		EXPECT_EQ(perc.GetNumberOfClusters(), expected.mClusters) << "seed " << seed;
+		EXPECT_EQ(perc.GetLargestClusterSize(), expected.mLargest) << "seed " << seed;
+	}
+}
+
+TEST(StreamingPercolationTest, TestAnalyzeFile)
+{
+	const int rows{31};
+	const int cols{13};
+	const auto grid = RandomGrid(rows, cols, 0.6, 7);
+	const Expected expected = LabelInMemory(grid);
+
+	const std::string path = TempPath("streaming_grid.bin");
+	{
+		std::ofstream out(path, std::ios::binary);
+		for (const auto& row : grid)
+		{
+			std::vector<char> bits((cols + 7) / 8, 0);
+			for (int c = 0; c < cols; c++)
+			{
+				if (row[c]) bits[c / 8] |= static_cast<char>(1 << (c % 8));
+			}
+			out.write(bits.data(), bits.size());
+		}
+	}
+
+	auto perc = nsperc::StreamingPercolation::AnalyzeFile(cols, path);
+	EXPECT_EQ(perc.Rows(), rows);
+	EXPECT_EQ(perc.DoesPercolate(), expected.mPercolates);
+	EXPECT_EQ(perc.GetNumberOfClusters(), expected.mClusters);
+	EXPECT_EQ(perc.GetLargestClusterSize(), expected.mLargest);
+
+	// a width that doesn't divide the file leaves a partial row.
+	ASSERT_THROW(nsperc::StreamingPercolation::AnalyzeFile(cols + 8, path), mabz::FileError);
+	std::remove(path.c_str());
+
+	ASSERT_THROW(nsperc::StreamingPercolation::AnalyzeFile(cols, TempPath("no_such_grid.bin")), mabz::FileError);
+}
+
+} /* anon namespace */
@@ -0,0 +1,128 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <algo_lib/bit_grid.h>
+#include <algo_lib/exceptions.h>
+#include <algo_lib/percolation.h>
+#include <algo_lib/tiled_percolation.h>
+#include <algo_lib/union_find.h>
+
+namespace {
+
+namespace nsperc = mabz::percolation;
+
+mabz::BitGrid RandomGrid(int rows, int cols, double p, unsigned seed)
+{
+	std::mt19937 randEng(seed);
+	std::bernoulli_distribution open(p);
+	mabz::BitGrid grid(rows, cols);
+	for (int r = 0; r < rows; r++)
+	{
+		for (int c = 0; c < cols; c++)
+		{
+			if (open(randEng)) grid.Set(r, c);
+		}
+	}
+	return grid;
+}
+
+TEST(TiledPercolationTest, TestConstructorThrows)
+{
+	ASSERT_THROW(nsperc::TiledPercolation(mabz::BitGrid(0, 5)), mabz::IllegalArgumentException);
+	ASSERT_THROW(nsperc::TiledPercolation(mabz::BitGrid(5, 0)), mabz::IllegalArgumentException);
+}
+
+TEST(TiledPercolationTest, TestBoundsChecks)
+{
+	nsperc::TiledPercolation perc(mabz::BitGrid(3, 4), 2);
+	ASSERT_THROW(perc.IsOpen(0, 1), mabz::IllegalArgumentException);
+	ASSERT_THROW(perc.IsFull(4, 1), mabz::IllegalArgumentException);
+	ASSERT_THROW(perc.GetClusterLabel(1, 5), mabz::IllegalArgumentException);
+	ASSERT_THROW(perc.Connected(1, 1, 1, 0), mabz::IllegalArgumentException);
+	EXPECT_FALSE(perc.DoesPercolate());
+	EXPECT_EQ(perc.GetNumberOfClusters(), 0);
+	EXPECT_EQ(perc.GetClusterLabel(2, 2), -1);
+}
+
+TEST(TiledPercolationTest, TestClusterSplitAcrossStrips)
+{
+	// a column down the middle crosses every strip boundary, with a
+	// sideways step in each strip.
+	mabz::BitGrid grid(8, 3);
+	for (int r = 0; r < 8; r++) grid.Set(r, r % 2 == 0 ? 1 : 2);
+	for (int r = 0; r < 8; r++) grid.Set(r, 1);
+	grid.Set(5, 0);
+
+	for (int threads : {1, 2, 3, 8, 20})
+	{
+		nsperc::TiledPercolation perc(grid, threads);
+		EXPECT_TRUE(perc.DoesPercolate()) << threads;
+		EXPECT_EQ(perc.GetNumberOfClusters(), 1) << threads;
+		EXPECT_EQ(perc.GetNumberOfOpenSites(), 13) << threads;
+		EXPECT_EQ(perc.GetLargestClusterSize(), 13) << threads;
+		EXPECT_TRUE(perc.Connected(1, 2, 8, 3)) << threads;
+		EXPECT_TRUE(perc.IsFull(6, 1)) << threads;
+		EXPECT_FALSE(perc.IsOpen(1, 1)) << threads;
+	}
+}
+
+TEST(TiledPercolationTest, TestMatchesPercolation)
+{
+	const int n{40};
+	for (unsigned seed = 0; seed < 20; seed++)
+	{
+		const mabz::BitGrid grid = RandomGrid(n, n, 0.5 + 0.01 * seed, seed);
+
+		nsperc::Percolation serial(n);
+		mabz::UnionFind<> clusters(n * n);
+		for (int r = 0; r < n; r++)
+		{
+			for (int c = 0; c < n; c++)
+			{
+				if (!grid.Get(r, c)) continue;
+				serial.Open(r+1, c+1);
+				if (c > 0 && grid.Get(r, c-1)) clusters.Union(r*n + c, r*n + c-1);
+				if (r > 0 && grid.Get(r-1, c)) clusters.Union(r*n + c, (r-1)*n + c);
+			}
+		}
+		// closed cells are singleton components of clusters.
+		const int expectedClusters = clusters.ComponentCount() - (n*n - serial.GetNumberOfOpenSites());
+
+		for (int threads : {1, 4, 7})
+		{
+			nsperc::TiledPercolation perc(grid, threads);
+			ASSERT_EQ(perc.DoesPercolate(), serial.DoesPercolate()) << seed;
+			ASSERT_EQ(perc.GetNumberOfOpenSites(), serial.GetNumberOfOpenSites()) << seed;
+			ASSERT_EQ(perc.GetNumberOfClusters(), expectedClusters) << seed;
+			for (int r = 1; r <= n; r++)
+			{
+				for (int c = 1; c <= n; c++)
+				{
+					ASSERT_EQ(perc.IsOpen(r, c), serial.IsOpen(r, c));
+					if (serial.IsOpen(r, c))
+					{
+						const int cell{(r-1)*n + (c-1)};
+						// not serial.IsFull, which sees "backwash" through the
+						// virtual bottom node once the grid percolates.
+						bool full{false};
+						for (int top = 0; top < n; top++)
+						{
+							if (grid.Get(0, top) && clusters.Connected(cell, top)) full = true;
+						}
+						ASSERT_EQ(perc.IsFull(r, c), full) << r << "," << c;
+						ASSERT_EQ(perc.GetClusterSize(r, c), clusters.ComponentSize(cell));
+						ASSERT_EQ(perc.Connected(r, c, 1, 1), serial.IsOpen(1, 1) && clusters.Connected(cell, 0));
+					}
+					else
+					{
+						ASSERT_FALSE(perc.IsFull(r, c));
+					}
+				}
+			}
+		}
+	}
+}
+
+} /* anon namespace */
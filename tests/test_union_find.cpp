@@ -1,6 +1,11 @@
 #include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include <algo_lib/exceptions.h>
 #include <algo_lib/union_find.h>
 
 namespace {
@@ -102,4 +107,162 @@ TEST(UnionFindTest, TestReset)
 	EXPECT_TRUE(uf.Connected(1, 4));
 }
 
-} /* anonymous namespace */
\ No newline at end of file
+TEST(UnionFindTest, TestMove)
+{
+	mabz::UnionFind<> uf(5);
+	uf.Union(1, 2);
+
+	mabz::UnionFind<> moved(std::move(uf));
+	EXPECT_TRUE(moved.Connected(2, 1));
+	EXPECT_EQ(moved.ComponentCount(), 4);
+	EXPECT_EQ(uf.Capacity(), 0);
+
+	mabz::UnionFind<> assigned(1);
+	assigned = std::move(moved);
+	EXPECT_EQ(assigned.Capacity(), 5);
+	EXPECT_TRUE(assigned.Connected(1, 2));
+}
+
+template <typename Policy>
+class UnionFindPolicyTest : public ::testing::Test {};
+
+using AllPolicies = ::testing::Types<
+	mabz::uf_policy::QuickFind,
+	mabz::uf_policy::WeightedQuickUnion,
+	mabz::uf_policy::UnionByRank,
+	mabz::uf_policy::PathCompression,
+	mabz::uf_policy::PathHalving,
+	mabz::uf_policy::PathSplitting>;
+TYPED_TEST_SUITE(UnionFindPolicyTest, AllPolicies);
+
+TYPED_TEST(UnionFindPolicyTest, TestChainsAndReset)
+{
+	const int n{64};
+	mabz::UnionFind<TypeParam> uf(n);
+
+	// two long interleaved chains: evens and odds.
+	for (int i = 2; i < n; i++)
+	{
+		uf.Union(i, i-2);
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			ASSERT_EQ(uf.Connected(i, j), (i % 2) == (j % 2));
+		}
+	}
+
+	uf.Union(0, 1);
+	EXPECT_TRUE(uf.Connected(n-1, n-2));
+
+	ASSERT_THROW(uf.Union(0, n), mabz::IndexOutOfRange);
+	ASSERT_THROW(uf.Connected(-1, 0), mabz::IndexOutOfRange);
+
+	uf.Reset();
+	EXPECT_FALSE(uf.Connected(0, 2));
+	EXPECT_TRUE(uf.Connected(5, 5));
+}
+
+TYPED_TEST(UnionFindPolicyTest, TestUncheckedMatchesChecked)
+{
+	const int n{100};
+	mabz::UnionFind<TypeParam> checked(n);
+	mabz::UnionFind<TypeParam> unchecked(n);
+	for (int i = 0; i < 150; i++)
+	{
+		const int a{(i * 37) % n};
+		const int b{(i * 61 + 3) % n};
+		checked.Union(a, b);
+		unchecked.UnionUnchecked(a, b);
+		ASSERT_EQ(unchecked.ComponentCount(), checked.ComponentCount()) << i;
+	}
+	for (int i = 0; i < n; i++)
+	{
+		ASSERT_EQ(unchecked.ConnectedUnchecked(i, (i * 13) % n), checked.Connected(i, (i * 13) % n)) << i;
+	}
+	EXPECT_EQ(unchecked.LargestComponentSize(), checked.LargestComponentSize());
+}
+
+TYPED_TEST(UnionFindPolicyTest, TestBatchMatchesSingle)
+{
+	const int n{500};
+	mabz::UnionFind<TypeParam> single(n);
+	mabz::UnionFind<TypeParam> batched(n);
+
+	// not a multiple of the prefetch distance, so the tail of the batch runs with
+	// nothing left to prefetch ahead of it.
+	std::vector<std::pair<int,int> > pairs;
+	for (int i = 0; i < 301; i++)
+	{
+		pairs.emplace_back((i * 37) % n, (i * 101 + 7) % n);
+	}
+	for (const auto& p : pairs)
+	{
+		single.Union(p.first, p.second);
+	}
+	batched.UnionBatch(pairs.data(), pairs.size());
+
+	std::vector<std::pair<int,int> > queries;
+	for (int i = 0; i < n; i++)
+	{
+		queries.emplace_back(i, (i * 13) % n);
+	}
+	std::unique_ptr<bool[]> results(new bool[queries.size()]);
+	batched.ConnectedBatch(queries.data(), queries.size(), results.get());
+	for (std::size_t i = 0; i < queries.size(); i++)
+	{
+		ASSERT_EQ(results[i], single.Connected(queries[i].first, queries[i].second)) << i;
+	}
+
+	// a bad index anywhere in the batch throws before anything is linked.
+	mabz::UnionFind<TypeParam> untouched(4);
+	std::vector<std::pair<int,int> > bad{{0, 1}, {2, 3}, {1, 4}};
+	ASSERT_THROW(untouched.UnionBatch(bad.data(), bad.size()), mabz::IndexOutOfRange);
+	EXPECT_FALSE(untouched.Connected(0, 1));
+}
+
+TYPED_TEST(UnionFindPolicyTest, TestComponentStatistics)
+{
+	mabz::UnionFind<TypeParam> uf(10, true);
+	EXPECT_EQ(uf.ComponentCount(), 10);
+	EXPECT_EQ(uf.LargestComponentSize(), 1);
+	EXPECT_EQ(uf.SizeHistogram()[1], 10);
+
+	uf.Union(0, 1);
+	uf.Union(2, 3);
+	uf.Union(3, 4);
+	uf.Union(4, 2);
+	EXPECT_EQ(uf.ComponentCount(), 7);
+	EXPECT_EQ(uf.ComponentSize(1), 2);
+	EXPECT_EQ(uf.ComponentSize(2), 3);
+	EXPECT_EQ(uf.ComponentSize(9), 1);
+	EXPECT_EQ(uf.LargestComponentSize(), 3);
+	EXPECT_EQ(uf.Find(2), uf.Find(4));
+	EXPECT_NE(uf.Find(0), uf.Find(4));
+
+	uf.Union(1, 4);
+	EXPECT_EQ(uf.ComponentCount(), 6);
+	EXPECT_EQ(uf.ComponentSize(3), 5);
+	EXPECT_EQ(uf.LargestComponentSize(), 5);
+
+	const std::vector<int>& histogram = uf.SizeHistogram();
+	EXPECT_EQ(histogram[1], 5);
+	EXPECT_EQ(histogram[2], 0);
+	EXPECT_EQ(histogram[3], 0);
+	EXPECT_EQ(histogram[5], 1);
+
+	uf.Reset();
+	EXPECT_EQ(uf.ComponentCount(), 10);
+	EXPECT_EQ(uf.LargestComponentSize(), 1);
+	EXPECT_EQ(uf.SizeHistogram()[1], 10);
+	EXPECT_EQ(uf.SizeHistogram()[5], 0);
+
+	ASSERT_THROW(uf.ComponentSize(10), mabz::IndexOutOfRange);
+	mabz::UnionFind<TypeParam> noHistogram(3);
+	EXPECT_FALSE(noHistogram.HasSizeHistogram());
+	ASSERT_THROW(noHistogram.SizeHistogram(), mabz::UnexpectedMethodCall);
+}
+
+} /* anonymous namespace */